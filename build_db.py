@@ -1,33 +1,48 @@
 # build_db.py
 
-from puzzle_service import PuzzleService, DB_FILENAME_BASE
-import time
+import argparse
 import math
+import time
+
+import cpp_solver
+
+from puzzle_service import DB_FILENAME_BASE
+
 
 def main():
     """
-    Builds the complete solution database and saves the files locally.
+    Thin driver around the native database builder: one C++ call runs the
+    multi-threaded BFS from the goal and serializes every state's optimal
+    move path into the mmap-able solution store the service loads at startup.
     """
-    TOTAL_POSSIBLE_STATES = math.factorial(9) // 2 
-    
+    parser = argparse.ArgumentParser(description="Build the puzzle solution database.")
+    parser.add_argument("--grid-size", type=int, default=3, choices=[3, 4],
+                        help="Board size (3 for the 8-puzzle, 4 for the 15-puzzle).")
+    parser.add_argument("--num-states", type=int, default=0,
+                        help="How many states (closest to the goal) to store. "
+                             "Defaults to the full reachable 3x3 space (9!/2).")
+    parser.add_argument("--threads", type=int, default=0,
+                        help="Worker threads (0 = one per core).")
+    args = parser.parse_args()
+
+    num_states = args.num_states
+    if num_states <= 0:
+        if args.grid_size != 3:
+            parser.error("--num-states is required for --grid-size 4 "
+                         "(the full 4x4 space does not fit in a database).")
+        num_states = math.factorial(9) // 2  # Every reachable 3x3 state
+
+    store_file = f"{DB_FILENAME_BASE}.store"
     print("=== Building Complete Solution Database Locally ===")
-    service = PuzzleService()
-    
+    print(f"Grid size {args.grid_size}, {num_states} states -> '{store_file}'")
+
     start_time = time.time()
-    # This function generates all states and solves them, populating the
-    # service's in-memory database attributes.
-    service.build_solution_database(TOTAL_POSSIBLE_STATES)
+    cpp_solver.build_solution_store(store_file, args.grid_size, num_states, args.threads)
     build_time = time.time() - start_time
-    
+
     print(f"\nDatabase built in {build_time:.2f} seconds")
-    
-    # Now, call the refactored save_database method to write the
-    # in-memory database to local files.
-    service.save_database()
-    
-    print("\nDatabase generation complete.")
-    print(f"Files created: '{DB_FILENAME_BASE}.faiss' and '{DB_FILENAME_BASE}_metadata.pkl'")
+    print(f"File created: '{store_file}'")
 
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
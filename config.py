@@ -15,3 +15,9 @@ load_dotenv()
 API_SECRET_TOKEN = os.getenv("API_SECRET_TOKEN")
 if not API_SECRET_TOKEN:
     raise ValueError("FATAL: API_SECRET_TOKEN environment variable not set.")
+
+# Per-request solve deadline in microseconds (0 disables the bound).
+# Tail-latency guard for the /solve endpoint: an adversarial state cannot
+# pin a worker past this budget — the solver answers with the best
+# incumbent path it found inside it instead.
+SOLVE_DEADLINE_MICROS = int(os.getenv("SOLVE_DEADLINE_MICROS", "0"))
@@ -0,0 +1,32 @@
+// bench/corpus.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <array>
+
+#include "../src/PuzzleSolver.hpp"
+
+// --- Graded Benchmark Corpus ---
+// 3x3 puzzles of known optimal solution depth (found by breadth-first search
+// from the goal), two per grade. Depth 31 is the hardest the 8-puzzle gets.
+// Keeping the corpus checked in makes benchmark runs comparable across
+// machines and commits.
+
+struct CorpusEntry {
+    State state;
+    int depth; // Optimal solution length in moves
+};
+
+inline constexpr std::array<CorpusEntry, 12> kCorpus = {{
+    {{1, 2, 3, 5, 6, 0, 4, 7, 8}, 5},
+    {{1, 2, 3, 5, 7, 6, 4, 0, 8}, 5},
+    {{1, 2, 3, 6, 0, 8, 5, 4, 7}, 10},
+    {{0, 2, 3, 1, 6, 8, 5, 4, 7}, 10},
+    {{1, 2, 3, 0, 8, 7, 6, 5, 4}, 15},
+    {{1, 2, 3, 6, 7, 0, 5, 8, 4}, 15},
+    {{2, 3, 7, 1, 0, 8, 6, 5, 4}, 20},
+    {{2, 3, 7, 1, 8, 4, 6, 5, 0}, 20},
+    {{2, 0, 7, 6, 3, 8, 5, 1, 4}, 25},
+    {{3, 1, 7, 2, 8, 0, 6, 5, 4}, 25},
+    {{8, 6, 7, 2, 5, 4, 3, 0, 1}, 31},
+    {{6, 4, 7, 8, 5, 0, 3, 2, 1}, 31},
+}};
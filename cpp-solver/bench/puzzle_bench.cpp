@@ -0,0 +1,95 @@
+// bench/puzzle_bench.cpp
+//
+// Google Benchmark suite for the solver. Run this before and after any
+// performance-affecting change; the end-to-end solves report nodes/second
+// as the primary regression metric.
+#include <benchmark/benchmark.h>
+
+#include "../src/PuzzleSolver.hpp"
+#include "../src/SearchNodeArena.hpp"
+#include "../src/SimdHeuristic.hpp"
+#include "corpus.hpp"
+
+// --- End-to-End Solves, Graded by Depth ---
+// One benchmark per corpus entry; the benchmark name carries the optimal
+// depth so regressions can be localized to shallow or deep puzzles.
+
+static void BM_SolveAStar(benchmark::State& bench_state) {
+    const CorpusEntry& entry = kCorpus[bench_state.range(0)];
+    PuzzleSolver<3> solver;
+    std::uint64_t nodes = 0;
+    for (auto _ : bench_state) {
+        SolveStats stats;
+        auto path = solver.solve_with_a_star(entry.state, &stats);
+        benchmark::DoNotOptimize(path);
+        nodes += stats.nodes_expanded;
+    }
+    bench_state.counters["nodes_per_second"] =
+        benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+    bench_state.SetLabel("depth=" + std::to_string(entry.depth));
+}
+BENCHMARK(BM_SolveAStar)->DenseRange(0, static_cast<int>(kCorpus.size()) - 1);
+
+static void BM_SolveIDAStar(benchmark::State& bench_state) {
+    const CorpusEntry& entry = kCorpus[bench_state.range(0)];
+    PuzzleSolver<3> solver;
+    for (auto _ : bench_state) {
+        auto path = solver.solve_with_ida_star(entry.state);
+        benchmark::DoNotOptimize(path);
+    }
+    bench_state.SetLabel("depth=" + std::to_string(entry.depth));
+}
+BENCHMARK(BM_SolveIDAStar)->DenseRange(0, static_cast<int>(kCorpus.size()) - 1);
+
+// --- Microbenchmarks for the Hot-Path Primitives ---
+
+static void BM_Heuristic(benchmark::State& bench_state) {
+    PuzzleSolver<3> solver;
+    std::array<PackedState, kCorpus.size()> packed;
+    for (size_t i = 0; i < kCorpus.size(); ++i) {
+        packed[i] = PuzzleSolver<3>::pack(kCorpus[i].state);
+    }
+    size_t i = 0;
+    for (auto _ : bench_state) {
+        benchmark::DoNotOptimize(solver.heuristic(packed[i]));
+        i = (i + 1) % packed.size();
+    }
+}
+BENCHMARK(BM_Heuristic);
+
+static void BM_HeuristicBatch(benchmark::State& bench_state) {
+    // The vectorized kernel against the same corpus; compare states/second
+    // here with BM_Heuristic's items/second to size the SIMD win.
+    std::array<std::uint64_t, kCorpus.size()> packed;
+    for (size_t i = 0; i < kCorpus.size(); ++i) {
+        packed[i] = PuzzleSolver<3>::pack(kCorpus[i].state);
+    }
+    std::array<std::int32_t, kCorpus.size()> out;
+    for (auto _ : bench_state) {
+        simd_heuristic::manhattan_batch(packed.data(), out.data(), packed.size(), 3);
+        benchmark::DoNotOptimize(out);
+    }
+    bench_state.SetItemsProcessed(
+        static_cast<std::int64_t>(bench_state.iterations() * packed.size()));
+}
+BENCHMARK(BM_HeuristicBatch);
+
+static void BM_ArenaIntern(benchmark::State& bench_state) {
+    // Successor to the old ArrayHasher microbenchmark: hashing now happens
+    // inside the arena's open-addressing index, so this times a full
+    // intern (hash + probe) over a stream of distinct neighbor states.
+    SearchNodeArena arena;
+    PackedState base = PuzzleSolver<3>::pack(kCorpus[0].state);
+    std::uint64_t salt = 0;
+    for (auto _ : bench_state) {
+        bool created;
+        benchmark::DoNotOptimize(arena.intern(base ^ (salt << 36), created));
+        ++salt;
+        if ((salt & 0xFFFFF) == 0) {
+            arena.clear();
+        }
+    }
+}
+BENCHMARK(BM_ArenaIntern);
+
+BENCHMARK_MAIN();
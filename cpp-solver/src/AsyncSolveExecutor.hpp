@@ -0,0 +1,232 @@
+// src/AsyncSolveExecutor.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Metrics.hpp"      // Coalescing counter for duplicate submissions
+#include "PuzzleSolver.hpp" // For StateOf, PackedState, Path
+
+// --- Asynchronous Solve Executor ---
+// A background executor for callers that must not block on a search: an
+// asyncio event loop, a UI thread. submit() enqueues the puzzle and returns
+// a SolveFuture immediately; a fixed set of worker threads pull tasks from
+// the queue and run the solves, each on its own long-lived PuzzleSolver so
+// the usual buffer-reuse and transposition-cache benefits apply per worker.
+//
+// Identical states submitted while a solve for them is still queued or
+// running coalesce onto the same future: burst traffic for one viral puzzle
+// costs one search, not one per request. Coalescing keys on the exact packed
+// state (not the symmetry-canonical form) because the returned moves are in
+// the submitted state's own frame.
+//
+// The queue is the same mutex-and-condition-variable design as ThreadPool:
+// tasks are whole solves, so a lock-free queue would shave nanoseconds off
+// operations that take milliseconds.
+
+/**
+ * @brief Handle to a solve running (or queued) on an AsyncSolveExecutor.
+ *
+ * Copies share the same underlying result. The result is delivered exactly
+ * once; callbacks registered after completion fire immediately in the
+ * registering thread, callbacks registered before fire in the worker thread
+ * that finished the solve.
+ */
+class SolveFuture {
+public:
+    using Callback = std::function<void(const std::optional<Path>&)>;
+
+    /** @brief True once the solve has finished (with or without a path). */
+    bool done() const {
+        std::unique_lock<std::mutex> lock(shared_->mutex);
+        return shared_->done;
+    }
+
+    /**
+     * @brief Blocks until the solve finishes and returns its path.
+     * @return The move path, or std::nullopt if no solution was found.
+     */
+    std::optional<Path> result() const {
+        std::unique_lock<std::mutex> lock(shared_->mutex);
+        shared_->cv.wait(lock, [this] { return shared_->done; });
+        return shared_->result;
+    }
+
+    /**
+     * @brief Registers a callback invoked with the result on completion.
+     */
+    void on_complete(Callback fn) {
+        {
+            std::unique_lock<std::mutex> lock(shared_->mutex);
+            if (!shared_->done) {
+                shared_->callbacks.push_back(std::move(fn));
+                return;
+            }
+        }
+        // Already complete: the result is immutable from here on, and the
+        // lock acquisition above ordered this read after its publication.
+        fn(shared_->result);
+    }
+
+private:
+    template <int N> friend class AsyncSolveExecutor;
+
+    struct Shared {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        std::optional<Path> result;
+        std::vector<Callback> callbacks;
+    };
+
+    explicit SolveFuture(std::shared_ptr<Shared> shared) : shared_(std::move(shared)) {}
+
+    static void complete(const std::shared_ptr<Shared>& shared, std::optional<Path> result) {
+        std::vector<Callback> callbacks;
+        {
+            std::unique_lock<std::mutex> lock(shared->mutex);
+            shared->result = std::move(result);
+            shared->done = true;
+            callbacks.swap(shared->callbacks);
+        }
+        shared->cv.notify_all();
+        for (Callback& callback : callbacks) {
+            callback(shared->result);
+        }
+    }
+
+    std::shared_ptr<Shared> shared_;
+};
+
+template <int N>
+class AsyncSolveExecutor {
+public:
+    /** @brief (state, optimal path) pair used to pre-warm a worker's cache. */
+    using Seed = std::pair<StateOf<N>, Path>;
+
+    /**
+     * @brief Starts the executor.
+     * @param factory Builds each worker's solver; lets the caller wire in a
+     *                pattern database or other configuration.
+     * @param num_threads Number of workers; 0 means "one per hardware thread".
+     */
+    explicit AsyncSolveExecutor(
+        std::function<PuzzleSolver<N>()> factory = [] { return PuzzleSolver<N>(); },
+        std::size_t num_threads = 0)
+        : factory_(std::move(factory)) {
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    // The executor owns its threads, so it must not be copied or moved.
+    AsyncSolveExecutor(const AsyncSolveExecutor&) = delete;
+    AsyncSolveExecutor& operator=(const AsyncSolveExecutor&) = delete;
+
+    /// Drains the queue (every submitted future still completes) and joins.
+    ~AsyncSolveExecutor() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Enqueues a solve and returns a future for its result.
+     *
+     * If an identical state is already queued or running, no new task is
+     * created: the returned future shares that solve's result, and the
+     * duplicate is counted in the async_solves_coalesced_total metric.
+     *
+     * @param state The starting state of the puzzle.
+     * @param deadline_micros Wall-clock budget per solve (anytime mode when
+     *                        non-zero); 0 runs plain A* to optimality.
+     * @param seed Optional known-optimal path used to prime the worker's
+     *             transposition cache right before this solve.
+     */
+    SolveFuture submit(const StateOf<N>& state, std::uint64_t deadline_micros = 0,
+                       std::optional<Seed> seed = std::nullopt) {
+        const PackedState key = PuzzleSolver<N>::pack(state);
+        std::shared_ptr<SolveFuture::Shared> shared;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto it = in_flight_.find(key);
+            if (it != in_flight_.end()) {
+                metrics::registry().async_solves_coalesced_total.inc();
+                return SolveFuture(it->second);
+            }
+            shared = std::make_shared<SolveFuture::Shared>();
+            in_flight_.emplace(key, shared);
+            tasks_.push(Task{state, key, deadline_micros, std::move(seed), shared});
+        }
+        cv_.notify_one();
+        return SolveFuture(shared);
+    }
+
+    std::size_t num_threads() const { return workers_.size(); }
+
+private:
+    struct Task {
+        StateOf<N> state;
+        PackedState key;
+        std::uint64_t deadline_micros;
+        std::optional<Seed> seed;
+        std::shared_ptr<SolveFuture::Shared> shared;
+    };
+
+    void worker_loop() {
+        PuzzleSolver<N> solver = factory_();
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return; // Stopping, and the queue has drained
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            if (task.seed) {
+                solver.seed_transposition_path(task.seed->first, task.seed->second);
+            }
+            std::optional<Path> result =
+                task.deadline_micros != 0
+                    ? solver.solve_anytime(task.state, task.deadline_micros)
+                    : solver.solve_with_a_star(task.state);
+            {
+                // Drop the in-flight entry before publishing the result, so
+                // a submit racing with completion either joins this solve
+                // or starts a fresh one — never misses the result.
+                std::unique_lock<std::mutex> lock(mutex_);
+                in_flight_.erase(task.key);
+            }
+            SolveFuture::complete(task.shared, std::move(result));
+        }
+    }
+
+    std::function<PuzzleSolver<N>()> factory_;
+    std::vector<std::thread> workers_;
+    std::queue<Task> tasks_;
+    std::unordered_map<PackedState, std::shared_ptr<SolveFuture::Shared>> in_flight_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
@@ -0,0 +1,123 @@
+// src/DaryHeap.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <algorithm>  // For std::min
+#include <cstdint>
+#include <vector>
+
+// --- Index-Based 4-Ary Min-Heap with Decrease-Key ---
+// The open list stores 8-byte (key, arena index) entries instead of the old
+// 40-byte (f, state) pairs, and a position table per node enables
+// decrease-key: when a node's g improves while queued, its entry is sifted
+// up in place rather than pushing a duplicate that must be popped and
+// discarded later. The branching factor of 4 halves the tree depth of a
+// binary heap and keeps each node's children in one cache line.
+class DaryHeap {
+public:
+    static constexpr std::uint32_t kNotInHeap = 0xFFFFFFFFu;
+    static constexpr int kArity = 4;
+
+    /**
+     * @brief Drops all entries but keeps the allocated storage for reuse.
+     */
+    void clear() {
+        entries_.clear();
+        positions_.clear();
+    }
+
+    bool empty() const { return entries_.empty(); }
+    std::size_t size() const { return entries_.size(); }
+
+    bool contains(std::uint32_t node) const {
+        return node < positions_.size() && positions_[node] != kNotInHeap;
+    }
+
+    /**
+     * @brief Inserts a node with the given key. The node must not be present.
+     */
+    void push(std::uint32_t node, int key) {
+        if (node >= positions_.size()) {
+            positions_.resize(node + 1, kNotInHeap);
+        }
+        entries_.push_back({key, node});
+        positions_[node] = static_cast<std::uint32_t>(entries_.size() - 1);
+        sift_up(entries_.size() - 1);
+    }
+
+    /**
+     * @brief Lowers the key of a queued node and restores heap order.
+     */
+    void decrease_key(std::uint32_t node, int new_key) {
+        std::uint32_t slot = positions_[node];
+        entries_[slot].key = new_key;
+        sift_up(slot);
+    }
+
+    /**
+     * @brief Removes and returns the node with the smallest key.
+     */
+    std::uint32_t pop_min() {
+        const std::uint32_t top = entries_.front().node;
+        positions_[top] = kNotInHeap;
+        if (entries_.size() > 1) {
+            entries_.front() = entries_.back();
+            entries_.pop_back();
+            positions_[entries_.front().node] = 0;
+            sift_down(0);
+        } else {
+            entries_.pop_back();
+        }
+        return top;
+    }
+
+private:
+    struct Entry {
+        int key;            // The f-score being ordered on
+        std::uint32_t node; // Arena index of the node
+    };
+
+    void sift_up(std::size_t slot) {
+        Entry moving = entries_[slot];
+        while (slot > 0) {
+            const std::size_t parent = (slot - 1) / kArity;
+            if (entries_[parent].key <= moving.key) {
+                break;
+            }
+            entries_[slot] = entries_[parent];
+            positions_[entries_[slot].node] = static_cast<std::uint32_t>(slot);
+            slot = parent;
+        }
+        entries_[slot] = moving;
+        positions_[moving.node] = static_cast<std::uint32_t>(slot);
+    }
+
+    void sift_down(std::size_t slot) {
+        Entry moving = entries_[slot];
+        const std::size_t count = entries_.size();
+        while (true) {
+            const std::size_t first_child = slot * kArity + 1;
+            if (first_child >= count) {
+                break;
+            }
+            // Pick the smallest of up to four children.
+            std::size_t best = first_child;
+            const std::size_t last_child = std::min(first_child + kArity, count);
+            for (std::size_t child = first_child + 1; child < last_child; ++child) {
+                if (entries_[child].key < entries_[best].key) {
+                    best = child;
+                }
+            }
+            if (entries_[best].key >= moving.key) {
+                break;
+            }
+            entries_[slot] = entries_[best];
+            positions_[entries_[slot].node] = static_cast<std::uint32_t>(slot);
+            slot = best;
+        }
+        entries_[slot] = moving;
+        positions_[moving.node] = static_cast<std::uint32_t>(slot);
+    }
+
+    std::vector<Entry> entries_;          // The heap itself, in level order
+    std::vector<std::uint32_t> positions_; // node -> slot in entries_, kNotInHeap if absent
+};
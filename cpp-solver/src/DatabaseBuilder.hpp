@@ -0,0 +1,183 @@
+// src/DatabaseBuilder.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PuzzleSolver.hpp"   // Board primitives and the neighbor tables
+#include "SolutionStore.hpp"  // The on-disk format the builder produces
+
+// --- Native Parallel Solution-Database Builder ---
+// One breadth-first sweep outward from the goal visits states in order of
+// increasing optimal distance and, at discovery time, already knows each
+// state's optimal first move: slide the tile now sitting where the parent's
+// blank was. That makes the separate solve-per-state pass of the old Python
+// pipeline redundant — enumerating the N closest states and chaining the
+// recorded moves IS solving them. The BFS runs layer-synchronously across
+// threads over a sharded visited map, and path materialization is then an
+// embarrassingly parallel chain walk, so the whole build is bounded by
+// memory bandwidth rather than Python tuple churn.
+namespace database_builder {
+
+namespace detail {
+
+// splitmix64 finalizer, the same mix the search-side hash tables use.
+inline std::uint64_t mix_state(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+} // namespace detail
+
+/**
+ * @brief Builds a solution store file for the `num_states` states closest
+ *        to the goal, BFS-ordered, using all requested cores.
+ *
+ * @param path Output file, in the SolutionStore on-disk format.
+ * @param num_states How many states to enumerate and serialize (the goal
+ *        itself counts as one, with an empty path).
+ * @param num_threads Worker threads; 0 means one per hardware core.
+ */
+template <int N>
+void build_solution_store(const std::string& path, std::size_t num_states,
+                          int num_threads = 0) {
+    using Solver = PuzzleSolver<N>;
+    if (num_states == 0) {
+        throw std::runtime_error("num_states must be positive.");
+    }
+    unsigned threads = num_threads > 0 ? static_cast<unsigned>(num_threads)
+                                       : std::thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    // The visited map is sharded by state hash so concurrent discovery only
+    // contends per shard, not on one global lock. Each entry records the
+    // state's optimal first move toward the goal (0xFF marks the goal).
+    constexpr int kNumShards = 64;
+    constexpr std::uint8_t kGoalEntry = 0xFF;
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<PackedState, std::uint8_t> next_cell;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+    shards.reserve(kNumShards);
+    for (int i = 0; i < kNumShards; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+    const auto shard_of = [&](PackedState state) -> Shard& {
+        return *shards[detail::mix_state(state) & (kNumShards - 1)];
+    };
+
+    const PackedState goal = Solver::make_goal();
+    shard_of(goal).next_cell.emplace(goal, kGoalEntry);
+
+    std::vector<PackedState> discovered{goal};
+    std::vector<PackedState> frontier{goal};
+
+    // Layer-synchronous BFS: every thread expands a slice of the current
+    // frontier into a private next-layer list; claims go through the shard
+    // the child hashes to, so each state is discovered exactly once.
+    while (discovered.size() < num_states && !frontier.empty()) {
+        std::vector<std::vector<PackedState>> next_locals(threads);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        const std::size_t chunk = (frontier.size() + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::vector<PackedState>& next_local = next_locals[t];
+                const std::size_t begin = t * chunk;
+                const std::size_t end = std::min(begin + chunk, frontier.size());
+                for (std::size_t i = begin; i < end; ++i) {
+                    const PackedState state = frontier[i];
+                    const int empty_index = Solver::find_empty(state);
+                    const auto& neighbors = Solver::kNeighbors[empty_index];
+                    for (int k = 0; k < neighbors.count; ++k) {
+                        const PackedState child = Solver::swap_tiles(
+                            state, empty_index, neighbors.entries[k].tile_index);
+                        Shard& shard = shard_of(child);
+                        bool inserted;
+                        {
+                            std::lock_guard<std::mutex> lock(shard.mutex);
+                            // From the child, the optimal move slides the tile
+                            // that just moved (now at this state's empty cell).
+                            inserted = shard.next_cell
+                                           .emplace(child, static_cast<std::uint8_t>(empty_index))
+                                           .second;
+                        }
+                        if (inserted) {
+                            next_local.push_back(child);
+                        }
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        frontier.clear();
+        for (std::vector<PackedState>& local : next_locals) {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+        }
+        // Append the layer, stopping mid-layer at the requested count the
+        // way the old Python walk did. The shard maps keep the full layer,
+        // so every serialized state's move chain stays intact.
+        for (PackedState state : frontier) {
+            if (discovered.size() >= num_states) {
+                break;
+            }
+            discovered.push_back(state);
+        }
+    }
+
+    // Materialize move paths by chaining next_cell entries down to the
+    // goal. Pure reads at this point, so the workers need no locks; they
+    // claim index batches from a shared cursor to stay balanced (deep
+    // states cost proportionally more to chain than shallow ones).
+    std::vector<std::pair<PackedState, Path>> entries(discovered.size());
+    {
+        std::atomic<std::size_t> cursor{0};
+        constexpr std::size_t kBatch = 1024;
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                while (true) {
+                    const std::size_t begin = cursor.fetch_add(kBatch);
+                    if (begin >= discovered.size()) {
+                        return;
+                    }
+                    const std::size_t end = std::min(begin + kBatch, discovered.size());
+                    for (std::size_t i = begin; i < end; ++i) {
+                        const PackedState state = discovered[i];
+                        Path moves;
+                        PackedState current = state;
+                        while (current != goal) {
+                            const int cell = shard_of(current).next_cell.at(current);
+                            moves.push_back({cell / N, cell % N});
+                            current = Solver::swap_tiles(current, Solver::find_empty(current), cell);
+                        }
+                        entries[i] = {state, std::move(moves)};
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    SolutionStore::write_file(path, N, std::move(entries));
+}
+
+} // namespace database_builder
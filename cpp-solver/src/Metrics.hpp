@@ -0,0 +1,110 @@
+// src/Metrics.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// --- Hot-Path Metrics Registry ---
+// Fleet-wide observability needs more than the per-call SolveStats: latency
+// histograms, cumulative node throughput and cache hit rates, aggregated
+// across every solve a worker runs. Sampling around the pybind call from
+// Python misattributes GIL wait time and is far too coarse for microsecond
+// solves, so the counters live here and are bumped on the native hot path.
+// Every update is a single relaxed atomic add — no locks, no memory-order
+// stalls — making the overhead a few nanoseconds per solve. Snapshots (the
+// get_metrics() binding) read the same atomics relaxed; Prometheus scrapes
+// tolerate the resulting slight skew between related series.
+namespace metrics {
+
+/**
+ * @brief A monotonically increasing relaxed-atomic counter.
+ */
+class Counter {
+public:
+    void inc(std::uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+/**
+ * @brief A fixed-bucket histogram with power-of-two upper bounds.
+ *
+ * Buckets are 1, 2, 4, ..., 2^(kNumBuckets-2) plus a final +inf bucket, so
+ * observing a value is one bit-width computation and one relaxed add. The
+ * ~2x bucket resolution is plenty for latency percentiles and keeps the
+ * whole histogram in two cache lines.
+ */
+class Histogram {
+public:
+    static constexpr int kNumBuckets = 22; // Upper bounds 1 .. 2^20, then +inf
+
+    void observe(std::uint64_t value) {
+        buckets_[bucket_for(value)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    struct Snapshot {
+        std::uint64_t count = 0;
+        std::uint64_t sum = 0;
+        // (upper bound, count in bucket); the last entry's bound is
+        // UINT64_MAX and stands for +inf.
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets;
+    };
+
+    Snapshot snapshot() const {
+        Snapshot snap;
+        snap.sum = sum_.load(std::memory_order_relaxed);
+        snap.buckets.reserve(kNumBuckets);
+        for (int i = 0; i < kNumBuckets; ++i) {
+            const std::uint64_t bound =
+                i < kNumBuckets - 1 ? (std::uint64_t{1} << i) : ~std::uint64_t{0};
+            const std::uint64_t count = buckets_[i].load(std::memory_order_relaxed);
+            snap.count += count;
+            snap.buckets.push_back({bound, count});
+        }
+        return snap;
+    }
+
+private:
+    static int bucket_for(std::uint64_t value) {
+        if (value <= 1) {
+            return 0;
+        }
+        // Index of the smallest power-of-two bound >= value.
+        const int bits = 64 - __builtin_clzll(value - 1);
+        return bits < kNumBuckets - 1 ? bits : kNumBuckets - 1;
+    }
+
+    std::array<std::atomic<std::uint64_t>, kNumBuckets> buckets_{};
+    std::atomic<std::uint64_t> sum_{0};
+};
+
+/**
+ * @brief The process-wide registry. One instance per worker process; all
+ *        solver objects and the tablebase feed the same series.
+ */
+struct Registry {
+    Counter solves_total;                     // A*/weighted solve calls completed
+    Counter solves_unsolvable_total;          // Solves answered "no solution"
+    Counter nodes_expanded_total;             // Across all solves (for nodes/sec)
+    Counter nodes_generated_total;
+    Counter transposition_cache_hits_total;   // Cache probes that found the state
+    Counter transposition_cache_misses_total;
+    Counter tablebase_solves_total;           // Tablebase walk-solves served
+    Counter tablebase_unsolvable_total;
+    Counter async_solves_coalesced_total;     // Duplicate submits that joined an in-flight solve
+    Histogram solve_latency_micros;           // Wall time per A* solve
+    Histogram batch_size;                     // States per solve_batch call
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+} // namespace metrics
@@ -0,0 +1,116 @@
+// src/MoveEncoding.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "PuzzleSolver.hpp" // For PackedState, Move, Path
+
+// --- Compact 2-Bit Move Encoding ---
+// A move always slides one of the (at most) four tiles adjacent to the
+// blank, so given the state a move applies to, two bits name it completely.
+// Packing four moves per byte shrinks a path from 8 bytes per move in the
+// in-memory Path representation (and 2 bytes in the old store format) to a
+// quarter byte — a 31-move solution is 8 bytes. The decoder replays the
+// directions from the starting state, tracking the blank to recover each
+// slid tile's (row, col); encoding is therefore only defined for valid
+// paths, which store paths are by construction.
+namespace move_encoding {
+
+// Where the slid tile sits relative to the blank.
+enum Direction : std::uint8_t { kUp = 0, kDown = 1, kLeft = 2, kRight = 3 };
+
+namespace detail {
+
+inline int find_empty(std::uint64_t state, int cells) {
+    for (int i = 0; i < cells; ++i) {
+        if (((state >> (4 * i)) & 0xF) == 0) {
+            return i;
+        }
+    }
+    throw std::runtime_error("Packed state has no empty cell.");
+}
+
+inline std::uint64_t swap_nibbles(std::uint64_t state, int a, int b) {
+    const std::uint64_t va = (state >> (4 * a)) & 0xF;
+    const std::uint64_t vb = (state >> (4 * b)) & 0xF;
+    const std::uint64_t x = va ^ vb;
+    return state ^ (x << (4 * a)) ^ (x << (4 * b));
+}
+
+} // namespace detail
+
+/**
+ * @brief Number of bytes a path of `num_moves` moves occupies encoded.
+ */
+inline std::size_t encoded_size(std::size_t num_moves) {
+    return (num_moves + 3) / 4;
+}
+
+/**
+ * @brief Encodes a move path as packed 2-bit directions.
+ *
+ * @param state The packed state the path starts from.
+ * @param path Moves as (row, col) of the slid tile; every move must be
+ *        adjacent to the blank at that point or the path is rejected.
+ * @param grid The board size (3 or 4).
+ * @throws std::runtime_error if a move does not slide a blank neighbor.
+ */
+inline std::vector<std::uint8_t> encode(std::uint64_t state, const Path& path, int grid) {
+    std::vector<std::uint8_t> bytes(encoded_size(path.size()), 0);
+    int empty_index = detail::find_empty(state, grid * grid);
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        const int tile_index = path[i].first * grid + path[i].second;
+        const int delta = tile_index - empty_index;
+        Direction dir;
+        if (delta == -grid) {
+            dir = kUp;
+        } else if (delta == grid) {
+            dir = kDown;
+        } else if (delta == -1 && empty_index % grid != 0) {
+            dir = kLeft;
+        } else if (delta == 1 && empty_index % grid != grid - 1) {
+            dir = kRight;
+        } else {
+            throw std::runtime_error("Path move does not slide a neighbor of the blank.");
+        }
+        bytes[i / 4] |= static_cast<std::uint8_t>(dir << (2 * (i % 4)));
+        state = detail::swap_nibbles(state, empty_index, tile_index);
+        empty_index = tile_index;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Decodes packed 2-bit directions back into (row, col) moves.
+ *
+ * Replays the directions from `state`, so the same starting state used for
+ * encoding must be supplied. The inverse of encode().
+ */
+inline Path decode(std::uint64_t state, const std::uint8_t* bytes,
+                   std::uint32_t num_moves, int grid) {
+    Path path;
+    path.reserve(num_moves);
+    int empty_index = detail::find_empty(state, grid * grid);
+    for (std::uint32_t i = 0; i < num_moves; ++i) {
+        const auto dir =
+            static_cast<Direction>((bytes[i / 4] >> (2 * (i % 4))) & 0x3);
+        int tile_index;
+        switch (dir) {
+            case kUp: tile_index = empty_index - grid; break;
+            case kDown: tile_index = empty_index + grid; break;
+            case kLeft: tile_index = empty_index - 1; break;
+            default: tile_index = empty_index + 1; break;
+        }
+        if (tile_index < 0 || tile_index >= grid * grid) {
+            throw std::runtime_error("Encoded path walks off the board.");
+        }
+        path.push_back({tile_index / grid, tile_index % grid});
+        state = detail::swap_nibbles(state, empty_index, tile_index);
+        empty_index = tile_index;
+    }
+    return path;
+}
+
+} // namespace move_encoding
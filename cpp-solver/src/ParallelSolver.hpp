@@ -0,0 +1,239 @@
+// src/ParallelSolver.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>     // For std::unique_ptr
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PuzzleSolver.hpp"
+
+// --- Hash-Distributed Parallel A* (HDA*) ---
+// One solve spread across all cores: a hash of the packed state assigns
+// every node to exactly one owner thread, which keeps that node's open-list
+// entry and g/parent bookkeeping. Generated neighbors are sent to their
+// owner's inbox, so no per-node structure is ever shared between threads —
+// the only cross-thread traffic is batched message passing plus a couple of
+// atomics for the incumbent bound and termination.
+//
+// Threads prune any node whose f-score cannot beat the best solution found
+// so far, and the search terminates when every inbox and open list has
+// drained; with an admissible heuristic the surviving incumbent is optimal.
+template <int N>
+class ParallelPuzzleSolver {
+public:
+    /**
+     * @param num_threads Worker count; 0 means "one per hardware thread".
+     */
+    explicit ParallelPuzzleSolver(int num_threads = 0) {
+        if (num_threads <= 0) {
+            num_threads = static_cast<int>(
+                std::max(1u, std::thread::hardware_concurrency()));
+        }
+        num_threads_ = num_threads;
+    }
+
+    /**
+     * @brief Solves one puzzle with hash-distributed A*.
+     * @return An std::optional containing the path of moves if a solution is found, otherwise std::nullopt.
+     */
+    std::optional<Path> solve(const StateOf<N>& initial_state) {
+        const PackedState initial_packed = PuzzleSolver<N>::pack(initial_state);
+        const PackedState goal = PuzzleSolver<N>::make_goal();
+        if (initial_packed == goal) {
+            return Path{};
+        }
+        if (!PuzzleSolver<N>::is_solvable(initial_packed)) {
+            return std::nullopt; // Wrong parity: skip spinning up the workers
+        }
+
+        shards_.clear();
+        for (int t = 0; t < num_threads_; ++t) {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+        pending_.store(0, std::memory_order_relaxed);
+        incumbent_cost_.store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+        goal_reached_ = false;
+        done_.store(false, std::memory_order_relaxed);
+
+        // Seed the owner of the initial state.
+        send(owner_of(initial_packed),
+             Message{initial_packed, 0, kNoParent, 0, 0});
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads_);
+        for (int t = 0; t < num_threads_; ++t) {
+            workers.emplace_back([this, t, goal] { worker_loop(t, goal); });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (!goal_reached_) {
+            return std::nullopt;
+        }
+        return reconstruct(initial_packed, goal);
+    }
+
+private:
+    static constexpr PackedState kNoParent = ~PackedState{0};
+
+    // A node handed to its owner thread: where it is, how it was reached.
+    struct Message {
+        PackedState state;
+        std::int32_t g;
+        PackedState parent;
+        std::uint8_t move_r;
+        std::uint8_t move_c;
+    };
+
+    // What an owner thread remembers about each of its nodes.
+    struct NodeInfo {
+        std::int32_t g;
+        PackedState parent;
+        std::uint8_t move_r;
+        std::uint8_t move_c;
+    };
+
+    // Per-thread state. Only the inbox is touched by other threads.
+    struct alignas(64) Shard {
+        std::mutex inbox_mutex;
+        std::vector<Message> inbox;
+        std::unordered_map<PackedState, NodeInfo> nodes;
+        // Min-heap of (f, -g, state): among equal f, the largest g pops
+        // first. Deeper nodes are closer to a goal under an equal bound,
+        // so this tie-break reaches the incumbent sooner and lets its cost
+        // prune the shards' remaining frontiers earlier.
+        std::priority_queue<std::tuple<int, int, PackedState>,
+                            std::vector<std::tuple<int, int, PackedState>>,
+                            std::greater<>> open;
+    };
+
+    int owner_of(PackedState state) const {
+        // splitmix64-style finalizer; neighbor states differ by single
+        // nibbles, so raw modulo would badly unbalance the shards.
+        std::uint64_t x = state + 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return static_cast<int>((x ^ (x >> 31)) % num_threads_);
+    }
+
+    void send(int owner, const Message& message) {
+        // pending_ counts every unit of outstanding work: messages sitting
+        // in inboxes plus entries sitting in open heaps. It only reaches
+        // zero when the whole distributed search has drained.
+        pending_.fetch_add(1, std::memory_order_acq_rel);
+        Shard& shard = *shards_[owner];
+        std::lock_guard<std::mutex> lock(shard.inbox_mutex);
+        shard.inbox.push_back(message);
+    }
+
+    void worker_loop(int thread_index, PackedState goal) {
+        Shard& shard = *shards_[thread_index];
+        PuzzleSolver<N> heuristic_solver;
+        std::vector<Message> batch;
+
+        while (!done_.load(std::memory_order_acquire)) {
+            // Pull everything waiting in the inbox in one lock acquisition.
+            {
+                std::lock_guard<std::mutex> lock(shard.inbox_mutex);
+                batch.swap(shard.inbox);
+            }
+            for (const Message& message : batch) {
+                auto it = shard.nodes.find(message.state);
+                if (it == shard.nodes.end() || message.g < it->second.g) {
+                    shard.nodes[message.state] =
+                        {message.g, message.parent, message.move_r, message.move_c};
+                    int f = message.g + heuristic_solver.heuristic(message.state);
+                    if (f < incumbent_cost_.load(std::memory_order_relaxed)) {
+                        // The pending unit moves from the inbox into the
+                        // open heap; it is released when the entry is popped.
+                        shard.open.push({f, -message.g, message.state});
+                        continue;
+                    }
+                }
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            batch.clear();
+
+            if (shard.open.empty()) {
+                // Nothing local to do: the search is over once no work is
+                // pending anywhere, otherwise give the inbox time to fill.
+                if (pending_.load(std::memory_order_acquire) == 0) {
+                    done_.store(true, std::memory_order_release);
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto [f, negated_g, state] = shard.open.top();
+            const int g = -negated_g;
+            shard.open.pop();
+
+            // Only expand entries that are fresh (not outdated by a better
+            // g) and can still beat the incumbent.
+            if (f < incumbent_cost_.load(std::memory_order_relaxed) &&
+                shard.nodes[state].g == g) {
+                if (state == goal) {
+                    std::lock_guard<std::mutex> lock(incumbent_mutex_);
+                    if (g < incumbent_cost_.load(std::memory_order_relaxed)) {
+                        incumbent_cost_.store(g, std::memory_order_relaxed);
+                        goal_reached_ = true;
+                    }
+                } else {
+                    const int empty_index = PuzzleSolver<N>::find_empty(state);
+                    const auto& neighbors = PuzzleSolver<N>::kNeighbors[empty_index];
+                    for (int k = 0; k < neighbors.count; ++k) {
+                        const auto& entry = neighbors.entries[k];
+                        const PackedState neighbor_state =
+                            PuzzleSolver<N>::swap_tiles(state, empty_index, entry.tile_index);
+                        const int neighbor_g = g + 1;
+                        const int neighbor_f =
+                            neighbor_g + heuristic_solver.heuristic(neighbor_state);
+                        if (neighbor_f < incumbent_cost_.load(std::memory_order_relaxed)) {
+                            send(owner_of(neighbor_state),
+                                 Message{neighbor_state, neighbor_g, state,
+                                         static_cast<std::uint8_t>(entry.move_r),
+                                         static_cast<std::uint8_t>(entry.move_c)});
+                        }
+                    }
+                }
+            }
+            // Release the popped entry's pending unit only after any child
+            // messages were counted, so pending_ never dips to zero while
+            // work still exists.
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    /**
+     * @brief Walks parent states backwards through the shard maps.
+     */
+    Path reconstruct(PackedState initial_packed, PackedState goal) const {
+        Path path;
+        PackedState state = goal;
+        while (state != initial_packed) {
+            const auto& nodes = shards_[owner_of(state)]->nodes;
+            const NodeInfo& info = nodes.at(state);
+            path.push_back({info.move_r, info.move_c});
+            state = info.parent;
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    int num_threads_ = 1;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<long> pending_{0};
+    std::atomic<int> incumbent_cost_{std::numeric_limits<int>::max()};
+    std::mutex incumbent_mutex_;
+    bool goal_reached_ = false;
+    std::atomic<bool> done_{false};
+};
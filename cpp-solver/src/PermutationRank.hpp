@@ -0,0 +1,60 @@
+// src/PermutationRank.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <cstdint>
+
+// --- Lehmer-Code Permutation Ranking ---
+// A 3x3 state is a permutation of the tiles 0..8, so it maps to a unique
+// rank in [0, 9! = 362,880). The rank is a perfect, dense index: tables and
+// arrays addressed by it need no hashing and waste no slots. Both the
+// endgame tablebase and the direct-indexed A* mode are built on this pair
+// of functions. The packed nibble layout matches PuzzleSolver::pack().
+namespace permutation_rank {
+
+constexpr std::uint32_t kNumPermutations = 362880; // 9!
+
+/**
+ * @brief Lehmer-code rank of a packed 3x3 state in [0, 9!).
+ */
+inline std::uint32_t rank(std::uint64_t state) {
+    // Classic Lehmer encoding: for each position, count the smaller
+    // tiles that appear to its right. 9 tiles keeps the O(n^2) scan
+    // trivially cheap.
+    std::uint32_t r = 0;
+    for (int i = 0; i < 9; ++i) {
+        int tile_i = static_cast<int>((state >> (4 * i)) & 0xF);
+        int smaller_after = 0;
+        for (int j = i + 1; j < 9; ++j) {
+            if (static_cast<int>((state >> (4 * j)) & 0xF) < tile_i) {
+                ++smaller_after;
+            }
+        }
+        r = r * (9 - i) + smaller_after;
+    }
+    return r;
+}
+
+/**
+ * @brief Inverse of rank(): rebuilds the packed state from its rank.
+ */
+inline std::uint64_t unrank(std::uint32_t r) {
+    constexpr std::uint32_t kFactorial[9] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320};
+    // Decode the factorial-base digits; digit i selects the i-th position's
+    // tile from the ascending list of tiles not yet placed.
+    int available[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    int remaining = 9;
+    std::uint64_t state = 0;
+    for (int i = 0; i < 9; ++i) {
+        const std::uint32_t f = kFactorial[8 - i];
+        const int digit = static_cast<int>(r / f);
+        r %= f;
+        state |= static_cast<std::uint64_t>(available[digit]) << (4 * i);
+        for (int j = digit; j < remaining - 1; ++j) {
+            available[j] = available[j + 1];
+        }
+        --remaining;
+    }
+    return state;
+}
+
+} // namespace permutation_rank
@@ -4,151 +4,936 @@
 #include <iostream>
 #include <vector>
 #include <array>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <chrono>     // For wall-clock solve timing
+#include <cstdint>    // For std::uint64_t
 #include <cmath>      // For std::abs
+#include <limits>     // For std::numeric_limits
 #include <algorithm>  // For std::reverse
 #include <optional>   // To handle the "no solution" case
+#include <stdexcept>  // For rejecting invalid weights
+
+#include "DaryHeap.hpp"         // Index-based open list with decrease-key
+#include "Metrics.hpp"          // Process-wide counters fed from the hot path
+#include "PatternDatabase.hpp"  // Optional precomputed heuristic tables
+#include "PermutationRank.hpp"     // Lehmer rank/unrank for the ranked A* mode
+#include "SearchNodeArena.hpp"     // Pooled node storage for the A* search
+#include "Symmetry.hpp"            // Diagonal-reflection canonicalization
+#include "TranspositionCache.hpp"  // Cross-call distance cache for clustered traffic
 
 // --- Type Aliases for Clarity (similar to Python's 'from typing import ...') ---
-using State = std::array<int, 9>;
+template <int N>
+using StateOf = std::array<int, N * N>;
+using State = StateOf<3>; // The common 3x3 case keeps its original name
 using Move = std::pair<int, int>;
 using Path = std::vector<Move>;
 
-// --- Custom Hasher for std::array ---
-// This is required to use std::array as a key in unordered_map/unordered_set.
-struct ArrayHasher {
-    std::size_t operator()(const State& a) const {
-        std::size_t h = 0;
-        for (auto e : a) {
-            h ^= std::hash<int>{}(e) + 0x9e3779b9 + (h << 6) + (h >> 2);
-        }
-        return h;
-    }
+// --- Packed State Representation ---
+// A puzzle state is a permutation of 0..N*N-1, so for N up to 4 each tile
+// fits in 4 bits and the whole board fits in a uint64_t (tile at board index
+// i lives in bits [4*i, 4*i+4); a 3x3 board uses 36 bits, a 4x4 board
+// exactly 64). The search uses this packed form everywhere: hash map keys
+// shrink to 8 bytes, hashing becomes a single integer hash, and copying a
+// state is one register move. The std::array form only appears at the
+// public API boundary.
+using PackedState = std::uint64_t;
+
+// --- Per-Solve Statistics ---
+// Cheap counters populated during a search when the caller asks for them.
+// These drive production SLOs and routing decisions (e.g. database lookup
+// versus fresh solve), so the fields mirror what operators actually watch.
+struct SolveStats {
+    std::uint64_t nodes_expanded = 0;   // Nodes popped from the open heap
+    std::uint64_t nodes_generated = 0;  // Neighbors produced (including duplicates)
+    std::uint64_t duplicate_hits = 0;   // Neighbors that mapped to an existing node
+    std::uint64_t peak_open_size = 0;   // Largest open heap seen
+    std::uint64_t total_nodes = 0;      // Nodes allocated in the arena (the closed + open set)
+    int root_heuristic = 0;             // Heuristic value of the initial state
+    std::uint64_t wall_micros = 0;      // Wall-clock duration of the solve
+    double suboptimality_bound = 1.0;   // Path length is at most this factor above optimal
+    bool deadline_expired = false;      // The deadline fired before the search finished
+    bool proven_optimal = false;        // The result is exact: optimal path or proven unsolvable
 };
 
+/**
+ * @brief A* / IDA* sliding-puzzle solver for an N x N board.
+ *
+ * The grid size is a template parameter so every division and modulo by N
+ * constant-folds, board sizes are static, and the 3x3 and 4x4 solvers are
+ * independently optimized instantiations rather than one runtime-branching
+ * implementation.
+ */
+template <int N = 3>
 class PuzzleSolver {
+    static_assert(N == 3 || N == 4, "Packed 4-bit tiles support 3x3 and 4x4 boards only.");
+
 public:
-    PuzzleSolver(int grid_size = 3) :
-        grid_size_(grid_size),
-        goal_state_({1, 2, 3, 4, 5, 6, 7, 8, 0}) {}
+    static constexpr int kNumCells = N * N;
+
+    PuzzleSolver() : goal_state_(make_goal()) {}
+
+    /**
+     * @brief Packs an unpacked state into its 4-bits-per-tile form.
+     */
+    static PackedState pack(const StateOf<N>& state) {
+        PackedState packed = 0;
+        for (int i = 0; i < kNumCells; ++i) {
+            packed |= static_cast<PackedState>(state[i]) << (4 * i);
+        }
+        return packed;
+    }
+
+    /**
+     * @brief Unpacks a packed state back into an std::array.
+     */
+    static StateOf<N> unpack(PackedState packed) {
+        StateOf<N> state;
+        for (int i = 0; i < kNumCells; ++i) {
+            state[i] = static_cast<int>((packed >> (4 * i)) & 0xF);
+        }
+        return state;
+    }
 
     /**
      * @brief The main A* solver function.
      * @param initial_state The starting state of the puzzle.
+     * @param stats If non-null, filled with instrumentation counters for this solve.
      * @return An std::optional containing the path of moves if a solution is found, otherwise std::nullopt.
      */
-    std::optional<Path> solve_with_a_star(const State& initial_state) {
-        if (initial_state == goal_state_) {
-            return Path{}; // Empty path
+    std::optional<Path> solve_with_a_star(const StateOf<N>& initial_state,
+                                          SolveStats* stats = nullptr) {
+        const auto start_time = std::chrono::steady_clock::now();
+        SolveStats local_stats;
+        // Record everything even when the caller passed no stats struct —
+        // the counters are single increments and keeping one code path is
+        // simpler than branching in the expansion loop. The process-wide
+        // registry is fed here too, so every solve shows up in the
+        // fleet-level series regardless of how it was invoked.
+        const auto finish = [&](std::optional<Path> result) {
+            local_stats.total_nodes = arena_.size();
+            local_stats.wall_micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_time).count();
+            metrics::Registry& registry = metrics::registry();
+            registry.solves_total.inc();
+            if (!result.has_value() && local_stats.proven_optimal) {
+                registry.solves_unsolvable_total.inc();
+            }
+            registry.nodes_expanded_total.inc(local_stats.nodes_expanded);
+            registry.nodes_generated_total.inc(local_stats.nodes_generated);
+            registry.solve_latency_micros.observe(local_stats.wall_micros);
+            if (stats != nullptr) {
+                *stats = local_stats;
+            }
+            return result;
+        };
+
+        const PackedState initial_packed = pack(initial_state);
+        local_stats.suboptimality_bound = weight_;
+        if (initial_packed == goal_state_) {
+            local_stats.suboptimality_bound = 1.0; // The empty path is trivially optimal
+            local_stats.proven_optimal = true;
+            return finish(Path{}); // Empty path
+        }
+        if (!is_solvable(initial_packed)) {
+            // Wrong parity: the goal is unreachable. Answering from the
+            // parity check turns the worst case — exhaustively expanding
+            // the entire reachable component — into a microsecond return.
+            local_stats.suboptimality_bound = 1.0;
+            local_stats.proven_optimal = true;
+            return finish(std::nullopt);
         }
+        // Computed only after validation: the heuristics assume a real
+        // permutation (the pattern database inverts tile -> position).
+        local_stats.root_heuristic = heuristic(initial_packed);
 
-        // The priority queue stores pairs of (f_score, state).
-        // std::greater makes it a min-heap, so the smallest f_score is always at the top.
-        using PQElement = std::pair<int, State>;
-        std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> open_heap;
+        // All per-node bookkeeping (g, h, parent link, move, open flag) lives
+        // in the arena; one open-addressing probe per neighbor replaces the
+        // former g_score / came_from / open_set_hash triple lookup. Both the
+        // arena and the open heap are members so repeated solves on a
+        // long-lived solver reuse their grown allocations instead of paying
+        // rehash/reallocation costs from a cold start.
+        arena_.clear();
+        open_heap_.clear();
 
-        // g_score map
-        std::unordered_map<State, int, ArrayHasher> g_score;
-        
-        // came_from map stores: child_state -> {parent_state, move_to_get_here}
-        std::unordered_map<State, std::pair<State, Move>, ArrayHasher> came_from;
+        // Initialize with the start node. Nodes are interned under their
+        // canonical (reflection-folded) state, so a state and its diagonal
+        // mirror share one closed-set entry; the mirrored flag records
+        // which of the two the search path actually reaches, and moves are
+        // always stored in that actual frame.
+        bool created;
+        const PackedState initial_canonical = symmetry::canonical<N>(initial_packed);
+        std::uint32_t root = arena_.intern(initial_canonical, created);
+        arena_[root].g = 0;
+        arena_[root].h = local_stats.root_heuristic;
+        arena_[root].in_open = true;
+        arena_[root].mirrored = (initial_canonical != initial_packed);
+        open_heap_.push(root, f_key(0, arena_[root].h));
+        local_stats.peak_open_size = 1;
 
-        // This set is equivalent to Python's open_set_hash
-        std::unordered_set<State, ArrayHasher> open_set_hash;
+        while (!open_heap_.empty()) {
+            std::uint32_t current = open_heap_.pop_min();
+            ++local_stats.nodes_expanded;
 
-        // Initialize with the start node
-        g_score[initial_state] = 0;
-        open_heap.push({heuristic(initial_state), initial_state});
-        open_set_hash.insert(initial_state);
+            // Deadline check, amortized: one clock read per 1024 expansions
+            // keeps the bound tight at microsecond scales without putting a
+            // syscall-backed timer call on every node.
+            if (deadline_micros_ != 0 && (local_stats.nodes_expanded & 0x3FF) == 0) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_time).count();
+                if (static_cast<std::uint64_t>(elapsed) >= deadline_micros_) {
+                    local_stats.deadline_expired = true;
+                    return finish(std::nullopt);
+                }
+            }
 
-        while (!open_heap.empty()) {
-            State current_state = open_heap.top().second;
-            open_heap.pop();
-            open_set_hash.erase(current_state);
+            // Copy what the expansion needs before interning neighbors: new
+            // nodes may grow the pool and invalidate references. The stored
+            // state is canonical; the actual state on the search path is its
+            // mirror when the flag says so (the goal mirrors to itself, so
+            // the goal test works on either).
+            const PackedState current_state = arena_[current].state;
+            const bool current_mirrored = arena_[current].mirrored;
+            const int current_g = arena_[current].g;
+            const int current_h = arena_[current].h;
+            arena_[current].in_open = false;
+            const PackedState current_actual =
+                current_mirrored ? symmetry::mirror<N>(current_state) : current_state;
 
             if (current_state == goal_state_) {
-                return reconstruct_move_path(came_from, current_state);
+                local_stats.proven_optimal = (weight_ == 1.0);
+                Path path = reconstruct_move_path(current);
+                if (weight_ == 1.0) {
+                    // The path is optimal, so every suffix distance is exact.
+                    update_transposition_cache(initial_packed, path);
+                }
+                return finish(std::move(path));
+            }
+
+            // Transposition cache hit: this state's exact distance-to-goal
+            // and its remaining moves are already known from an earlier
+            // solve. g + distance is a real solution through this node but
+            // not necessarily the optimal one, so the exact distance is
+            // first adopted as the node's heuristic (it dominates the
+            // estimate and stays admissible) and the node goes back on the
+            // open list. When it is re-popped, f = g + distance is the
+            // minimum f in the open list, which proves that solution
+            // optimal — then the rest is a chain walk, not a search.
+            // Only valid at w = 1, where popped g-scores are optimal.
+            if (weight_ == 1.0 && tt_cache_.capacity() != 0) {
+                const TranspositionCache::Entry* hit = tt_cache_.find(current_state);
+                if (hit == nullptr) {
+                    metrics::registry().transposition_cache_misses_total.inc();
+                } else {
+                    metrics::registry().transposition_cache_hits_total.inc();
+                    if (hit->distance == current_h) {
+                        Path tail;
+                        if (chain_from_cache(current_actual, *hit, tail)) {
+                            Path path = reconstruct_move_path(current);
+                            path.insert(path.end(), tail.begin(), tail.end());
+                            local_stats.proven_optimal = true;
+                            update_transposition_cache(initial_packed, path);
+                            return finish(std::move(path));
+                        }
+                    } else if (hit->distance > current_h) {
+                        SearchNode& node = arena_[current];
+                        node.h = hit->distance;
+                        node.in_open = true;
+                        open_heap_.push(current, f_key(node.g, node.h));
+                        continue;
+                    }
+                }
             }
 
-            int empty_index = -1;
-            for (size_t i = 0; i < current_state.size(); ++i) {
-                if (current_state[i] == 0) {
-                    empty_index = i;
+            int empty_index = find_empty(current_actual);
+
+            // Explore neighbors straight from the precomputed table. Moves
+            // are generated in the actual frame; only the closed-set key is
+            // folded. The reflection preserves distances, so the heuristic
+            // of the actual neighbor is also the canonical node's.
+            const NeighborList& neighbors = kNeighbors[empty_index];
+            for (int k = 0; k < neighbors.count; ++k) {
+                const NeighborEntry& entry = neighbors.entries[k];
+                const int tile_index = entry.tile_index;
+                PackedState neighbor_actual = swap_tiles(current_actual, empty_index, tile_index);
+                const PackedState neighbor_canonical = symmetry::canonical<N>(neighbor_actual);
+
+                int tentative_g_score = current_g + 1;
+
+                ++local_stats.nodes_generated;
+                std::uint32_t neighbor = arena_.intern(neighbor_canonical, created);
+                if (!created) {
+                    ++local_stats.duplicate_hits;
+                }
+                SearchNode& node = arena_[neighbor];
+                if (created || tentative_g_score < node.g) {
+                    node.g = tentative_g_score;
+                    node.parent = current;
+                    node.move_r = static_cast<std::uint8_t>(entry.move_r);
+                    node.move_c = static_cast<std::uint8_t>(entry.move_c);
+                    node.mirrored = (neighbor_canonical != neighbor_actual);
+                    if (created) {
+                        // The neighbor differs from current by one tile
+                        // sliding from tile_index to empty_index, so its
+                        // heuristic is the parent's plus a single-tile delta.
+                        node.h = child_heuristic(current_h, neighbor_actual,
+                                                 tile_at(current_actual, tile_index),
+                                                 tile_index, empty_index);
+                    }
+                    if (node.in_open) {
+                        // Already queued with a worse g: sift its entry up
+                        // in place instead of pushing a duplicate.
+                        open_heap_.decrease_key(neighbor, f_key(node.g, node.h));
+                    } else {
+                        node.in_open = true;
+                        open_heap_.push(neighbor, f_key(node.g, node.h));
+                        if (open_heap_.size() > local_stats.peak_open_size) {
+                            local_stats.peak_open_size = open_heap_.size();
+                        }
+                    }
+                }
+            }
+        }
+
+        local_stats.proven_optimal = true; // Exhausted the reachable space: provably unsolvable
+        return finish(std::nullopt); // No solution found
+    }
+
+    /**
+     * @brief Anytime solver: the best path obtainable within a deadline.
+     *
+     * Runs weighted A* restarts over a decreasing weight schedule. The
+     * early, heavily weighted passes are cheap and establish an incumbent
+     * quickly; each later pass tightens the suboptimality bound, and a
+     * completed final w = 1 pass proves optimality. When the deadline
+     * fires mid-pass the best incumbent so far is returned, with
+     * stats->proven_optimal false and stats->suboptimality_bound carrying
+     * the bound of the pass that produced it.
+     *
+     * @param initial_state The starting state of the puzzle.
+     * @param deadline_micros Wall-clock budget for the whole call; 0 means unlimited.
+     * @param stats If non-null, filled with the stats of the pass that produced the result.
+     * @return The best path found, or std::nullopt if none was found in time.
+     */
+    std::optional<Path> solve_anytime(const StateOf<N>& initial_state,
+                                      std::uint64_t deadline_micros,
+                                      SolveStats* stats = nullptr) {
+        const auto start_time = std::chrono::steady_clock::now();
+        static constexpr double kWeightSchedule[] = {3.0, 2.0, 1.5, 1.2, 1.0};
+
+        // The restarts borrow the regular weighted/deadline machinery, so
+        // save and restore whatever the caller had configured.
+        const double saved_weight = weight_;
+        const std::uint64_t saved_deadline = deadline_micros_;
+
+        std::optional<Path> best;
+        SolveStats best_stats;
+        for (double pass_weight : kWeightSchedule) {
+            std::uint64_t remaining = 0; // Unlimited
+            if (deadline_micros != 0) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_time).count();
+                if (static_cast<std::uint64_t>(elapsed) >= deadline_micros) {
+                    best_stats.deadline_expired = true;
                     break;
                 }
+                remaining = deadline_micros - static_cast<std::uint64_t>(elapsed);
             }
 
-            int empty_r = empty_index / grid_size_;
-            int empty_c = empty_index % grid_size_;
+            weight_ = pass_weight;
+            deadline_micros_ = remaining;
+            SolveStats pass_stats;
+            std::optional<Path> path = solve_with_a_star(initial_state, &pass_stats);
 
-            // Explore neighbors
-            for (const auto& move : std::vector<Move>{{0, 1}, {0, -1}, {1, 0}, {-1, 0}}) {
-                int tile_r = empty_r + move.first;
-                int tile_c = empty_c + move.second;
+            if (path.has_value() && (!best.has_value() || path->size() <= best->size())) {
+                best = std::move(path);
+                best_stats = pass_stats;
+            } else if (pass_stats.deadline_expired) {
+                best_stats.deadline_expired = true;
+            }
+            if (pass_stats.deadline_expired) {
+                break;
+            }
+            if (!best.has_value()) {
+                // The pass ran to exhaustion without a path: the puzzle is
+                // unsolvable and no weight will change that.
+                best_stats = pass_stats;
+                break;
+            }
+        }
+        weight_ = saved_weight;
+        deadline_micros_ = saved_deadline;
 
-                if (tile_r >= 0 && tile_r < grid_size_ && tile_c >= 0 && tile_c < grid_size_) {
-                    int tile_index = tile_r * grid_size_ + tile_c;
-                    State neighbor_state = current_state;
-                    std::swap(neighbor_state[empty_index], neighbor_state[tile_index]);
+        if (stats != nullptr) {
+            best_stats.wall_micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_time).count();
+            *stats = best_stats;
+        }
+        return best;
+    }
 
-                    int tentative_g_score = g_score.at(current_state) + 1;
+    /**
+     * @brief A* over flat arrays indexed by Lehmer rank instead of hashing.
+     *
+     * Only for the 3x3 board: its 9! = 362,880 permutations are few enough
+     * that g-scores and parent moves live in direct-indexed byte arrays
+     * (355 KB each, L2-resident) addressed by the state's permutation
+     * rank. No hashing, no collision probing, no node arena — the
+     * per-neighbor lookup is one ranking pass plus an array read. The
+     * g array doubles as the visited set (0xFF = never seen).
+     *
+     * @param initial_state The starting state of the puzzle.
+     * @param stats If non-null, filled with instrumentation counters for this solve.
+     * @return An std::optional containing the path of moves if a solution is found, otherwise std::nullopt.
+     */
+    std::optional<Path> solve_with_ranked_a_star(const StateOf<N>& initial_state,
+                                                 SolveStats* stats = nullptr) {
+        static_assert(N == 3, "Lehmer ranking covers the 3x3 puzzle only.");
+        const auto start_time = std::chrono::steady_clock::now();
+        SolveStats local_stats;
+        const auto finish = [&](std::optional<Path> result) {
+            if (stats != nullptr) {
+                local_stats.wall_micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_time).count();
+                *stats = local_stats;
+            }
+            return result;
+        };
+
+        const PackedState initial_packed = pack(initial_state);
+        if (initial_packed == goal_state_) {
+            local_stats.proven_optimal = true;
+            return finish(Path{});
+        }
+        if (!is_solvable(initial_packed)) {
+            local_stats.proven_optimal = true; // Parity proves it without search
+            return finish(std::nullopt);
+        }
+        local_stats.root_heuristic = heuristic(initial_packed);
 
-                    if (!g_score.count(neighbor_state) || tentative_g_score < g_score.at(neighbor_state)) {
-                        came_from[neighbor_state] = {current_state, {tile_r, tile_c}};
-                        g_score[neighbor_state] = tentative_g_score;
-                        int f_score = tentative_g_score + heuristic(neighbor_state);
+        // Allocated on first use, then re-filled per solve: resetting both
+        // arrays is two 355 KB memsets, cheaper than the rehashing a
+        // hash-based closed set pays as it grows.
+        ranked_g_.assign(permutation_rank::kNumPermutations, 0xFF);
+        ranked_parent_.assign(permutation_rank::kNumPermutations, 0xFF);
+        open_heap_.clear();
 
-                        if (open_set_hash.find(neighbor_state) == open_set_hash.end()) {
-                            open_heap.push({f_score, neighbor_state});
-                            open_set_hash.insert(neighbor_state);
-                        }
+        const std::uint32_t root_rank = permutation_rank::rank(initial_packed);
+        ranked_g_[root_rank] = 0;
+        ++local_stats.total_nodes;
+        open_heap_.push(root_rank, local_stats.root_heuristic);
+        local_stats.peak_open_size = 1;
+
+        while (!open_heap_.empty()) {
+            const std::uint32_t current_rank = open_heap_.pop_min();
+            ++local_stats.nodes_expanded;
+
+            const PackedState current_state = permutation_rank::unrank(current_rank);
+            if (current_state == goal_state_) {
+                local_stats.proven_optimal = true;
+                return finish(reconstruct_ranked_path(current_state, current_rank));
+            }
+            const int current_g = ranked_g_[current_rank];
+            const int current_h = heuristic(current_state);
+            const int empty_index = find_empty(current_state);
+
+            const NeighborList& neighbors = kNeighbors[empty_index];
+            for (int k = 0; k < neighbors.count; ++k) {
+                const NeighborEntry& entry = neighbors.entries[k];
+                const int tile_index = entry.tile_index;
+                const PackedState neighbor_state =
+                    swap_tiles(current_state, empty_index, tile_index);
+                const std::uint32_t neighbor_rank = permutation_rank::rank(neighbor_state);
+                const int tentative_g_score = current_g + 1;
+
+                ++local_stats.nodes_generated;
+                if (tentative_g_score >= ranked_g_[neighbor_rank]) {
+                    ++local_stats.duplicate_hits; // Known state with an equal or better g
+                    continue;
+                }
+                if (ranked_g_[neighbor_rank] == 0xFF) {
+                    ++local_stats.total_nodes;
+                } else {
+                    ++local_stats.duplicate_hits;
+                }
+                ranked_g_[neighbor_rank] = static_cast<std::uint8_t>(tentative_g_score);
+                // The parent is recoverable from the move alone: record the
+                // blank's position in the parent and reconstruction can undo
+                // the slide — no 32-bit parent links needed.
+                ranked_parent_[neighbor_rank] = static_cast<std::uint8_t>(empty_index);
+                const int f = tentative_g_score +
+                    child_heuristic(current_h, neighbor_state,
+                                    tile_at(current_state, tile_index),
+                                    tile_index, empty_index);
+                if (open_heap_.contains(neighbor_rank)) {
+                    open_heap_.decrease_key(neighbor_rank, f);
+                } else {
+                    open_heap_.push(neighbor_rank, f);
+                    if (open_heap_.size() > local_stats.peak_open_size) {
+                        local_stats.peak_open_size = open_heap_.size();
                     }
                 }
             }
         }
 
-        return std::nullopt; // No solution found
+        local_stats.proven_optimal = true; // Exhausted the reachable space: provably unsolvable
+        return finish(std::nullopt); // No solution found
     }
 
-private:
-    int grid_size_;
-    State goal_state_;
+    /**
+     * @brief Sets the weighted A* weight: the open list orders on f = g + w*h.
+     *
+     * w = 1 (the default) keeps the search optimal. w > 1 inflates the
+     * heuristic, which focuses expansions toward the goal and cuts node
+     * counts sharply on deep puzzles, in exchange for paths that may be up
+     * to w times longer than optimal — that factor is reported per solve
+     * in SolveStats::suboptimality_bound. Applies to solve_with_a_star.
+     *
+     * @throws std::runtime_error if weight < 1 (the bound would be meaningless).
+     */
+    void set_weight(double weight) {
+        if (weight < 1.0) {
+            throw std::runtime_error("Weighted A* requires weight >= 1.0.");
+        }
+        weight_ = weight;
+    }
+
+    double weight() const { return weight_; }
+
+    /**
+     * @brief Bounds solve_with_a_star to a wall-clock budget in microseconds.
+     *
+     * When the budget runs out the search stops and returns std::nullopt
+     * with SolveStats::deadline_expired set, so callers can tell a timeout
+     * apart from a proven "no solution". 0 (the default) disables the
+     * bound. The check costs one clock read per 1024 expansions.
+     */
+    void set_deadline_micros(std::uint64_t micros) { deadline_micros_ = micros; }
+
+    /**
+     * @brief Resizes the cross-call transposition cache; 0 disables it.
+     *
+     * The cache maps packed states to their exact distance-to-goal and
+     * optimal next move, is updated from every completed optimal solve,
+     * and lets later solves that reach a cached state finish without
+     * further search. It persists across solve calls on a long-lived
+     * solver, which is where clustered traffic earns its hits.
+     */
+    void set_transposition_cache_capacity(std::size_t capacity) {
+        tt_cache_.set_capacity(capacity);
+    }
+
+    std::size_t transposition_cache_size() const { return tt_cache_.size(); }
+
+    /**
+     * @brief Seeds the transposition cache with a known optimal path.
+     *
+     * Lets callers prime a long-lived solver from stored solutions — e.g.
+     * the solution store's nearest neighbor of an incoming query — so the
+     * next solve terminates the moment it reaches any state on the seeded
+     * path. The path MUST be optimal for its state (solution-store paths
+     * are, by construction): cached distances are treated as exact.
+     */
+    void seed_transposition_path(const StateOf<N>& initial_state, const Path& path) {
+        update_transposition_cache(pack(initial_state), path);
+    }
+
+    /**
+     * @brief Switches the heuristic to a precomputed pattern database.
+     *
+     * The database must outlive the solver. Passing nullptr reverts to the
+     * on-the-fly Manhattan distance heuristic. Only available on the 3x3
+     * solver — the tables cover the 8-puzzle tile partition.
+     */
+    void set_pattern_database(const PatternDatabase* pdb) {
+        static_assert(N == 3, "The pattern database covers the 3x3 puzzle only.");
+        pdb_ = pdb;
+    }
 
     /**
-     * @brief Calculates the Manhattan distance heuristic.
+     * @brief Heuristic estimate for a packed state.
+     *
+     * Uses the pattern database when one is attached (a pair of table
+     * lookups), otherwise computes Manhattan distance on the fly. Public so
+     * callers (and the benchmark suite) can inspect or time it directly.
      */
-    int heuristic(const State& state) const {
+    int heuristic(PackedState state) const {
+        if constexpr (N == 3) {
+            if (pdb_ != nullptr) {
+                return pdb_->lookup(state);
+            }
+        }
         int distance = 0;
-        for (size_t i = 0; i < state.size(); ++i) {
-            int num = state[i];
+        for (int i = 0; i < kNumCells; ++i) {
+            int num = tile_at(state, i);
             if (num != 0) {
-                int goal_index = num - 1;
-                int current_r = i / grid_size_;
-                int current_c = i % grid_size_;
-                int goal_r = goal_index / grid_size_;
-                int goal_c = goal_index % grid_size_;
-                distance += std::abs(current_r - goal_r) + std::abs(current_c - goal_c);
+                distance += manhattan_for_tile(num, i);
             }
         }
         return distance;
     }
 
     /**
-     * @brief Reconstructs the path of moves from the came_from map.
+     * @brief Solves the puzzle with IDA* (iterative-deepening A*).
+     *
+     * IDA* repeats a depth-first search with a growing f-score bound. It
+     * re-expands some nodes across iterations, but needs no g_score /
+     * came_from / open_set maps — memory use is O(depth) instead of
+     * growing with the number of states visited. This is the mode to use
+     * when a bounded memory footprint matters more than raw node counts.
+     *
+     * @param initial_state The starting state of the puzzle.
+     * @return An std::optional containing the path of moves if a solution is found, otherwise std::nullopt.
+     */
+    std::optional<Path> solve_with_ida_star(const StateOf<N>& initial_state) {
+        const PackedState initial_packed = pack(initial_state);
+        if (initial_packed == goal_state_) {
+            return Path{}; // Empty path
+        }
+        if (!is_solvable(initial_packed)) {
+            return std::nullopt; // Wrong parity: no bound will ever succeed
+        }
+
+        Path path;
+        int bound = heuristic(initial_packed);
+        while (true) {
+            int next_bound = ida_search(initial_packed, 0, bound, /*prev_empty_index=*/-1, path);
+            if (next_bound == kFound) {
+                return path;
+            }
+            if (next_bound == kNoSolution) {
+                return std::nullopt;
+            }
+            bound = next_bound; // Deepen to the smallest f-score that exceeded the bound
+        }
+    }
+
+    // --- Compile-Time Neighbor Tables ---
+    // For every position of the empty cell, the set of tiles that can slide
+    // into it is fixed, so it is precomputed once at compile time. The
+    // expansion loops index this table directly instead of building a move
+    // vector and bounds-checking four candidate directions per node.
+    // Public alongside the board primitives below so other search
+    // implementations (e.g. the parallel solver) share one definition.
+    struct NeighborEntry {
+        std::int8_t tile_index; // Board index of the tile that can slide
+        std::int8_t move_r;     // That tile's row (recorded in the move path)
+        std::int8_t move_c;     // That tile's column
+    };
+    struct NeighborList {
+        std::array<NeighborEntry, 4> entries;
+        int count;
+    };
+
+    static constexpr std::array<NeighborList, kNumCells> make_neighbor_table() {
+        std::array<NeighborList, kNumCells> table{};
+        for (int empty_index = 0; empty_index < kNumCells; ++empty_index) {
+            NeighborList& list = table[empty_index];
+            list.count = 0;
+            const int empty_r = empty_index / N;
+            const int empty_c = empty_index % N;
+            constexpr int offsets[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+            for (const auto& offset : offsets) {
+                const int tile_r = empty_r + offset[0];
+                const int tile_c = empty_c + offset[1];
+                if (tile_r >= 0 && tile_r < N && tile_c >= 0 && tile_c < N) {
+                    list.entries[list.count++] = {
+                        static_cast<std::int8_t>(tile_r * N + tile_c),
+                        static_cast<std::int8_t>(tile_r),
+                        static_cast<std::int8_t>(tile_c)};
+                }
+            }
+        }
+        return table;
+    }
+
+    static constexpr std::array<NeighborList, kNumCells> kNeighbors = make_neighbor_table();
+
+    /**
+     * @brief Builds the packed goal state 1, 2, ..., N*N-1, 0.
+     */
+    static constexpr PackedState make_goal() {
+        PackedState goal = 0;
+        for (int i = 0; i < kNumCells - 1; ++i) {
+            goal |= static_cast<PackedState>(i + 1) << (4 * i);
+        }
+        return goal;
+    }
+
+    /**
+     * @brief Extracts the tile at a board index from a packed state.
+     */
+    static int tile_at(PackedState state, int index) {
+        return static_cast<int>((state >> (4 * index)) & 0xF);
+    }
+
+    /**
+     * @brief Returns the board index of the empty (0) tile.
+     */
+    static int find_empty(PackedState state) {
+        for (int i = 0; i < kNumCells; ++i) {
+            if (((state >> (4 * i)) & 0xF) == 0) {
+                return i;
+            }
+        }
+        return -1; // Unreachable for a valid state
+    }
+
+    /**
+     * @brief Whether a state can reach the goal at all.
+     *
+     * Every slide transposes the blank with one tile, flipping the
+     * permutation's parity, and moves the blank one step, flipping the
+     * parity of its taxicab distance to the goal corner. The two parities
+     * therefore stay equal along any path, and both are even at the goal —
+     * so a state is solvable exactly when they match. The permutation's
+     * parity comes from its cycle decomposition ((cells - cycles) mod 2),
+     * making the whole check O(n) with no search.
+     *
+     * Non-permutation inputs (tile values out of range, duplicates, no
+     * blank) reach this entry point too — the bindings and the CLI only
+     * validate length — and are rejected up front: they cannot reach the
+     * goal by definition, and the cycle walk below would index out of
+     * bounds on them.
+     */
+    static bool is_solvable(PackedState state) {
+        std::array<bool, 16> seen{}; // A nibble can hold 0-15 regardless of N
+        for (int i = 0; i < kNumCells; ++i) {
+            const int tile = tile_at(state, i);
+            if (tile >= kNumCells || seen[tile]) {
+                return false;
+            }
+            seen[tile] = true;
+        }
+        std::array<bool, kNumCells> visited{};
+        int parity = 0;
+        for (int i = 0; i < kNumCells; ++i) {
+            if (visited[i]) {
+                continue;
+            }
+            int cycle_length = 0;
+            int j = i;
+            while (!visited[j]) {
+                visited[j] = true;
+                const int tile = tile_at(state, j);
+                j = (tile == 0) ? kNumCells - 1 : tile - 1; // The tile's goal cell
+                ++cycle_length;
+            }
+            parity ^= (cycle_length - 1) & 1;
+        }
+        const int empty_index = find_empty(state);
+        const int blank_distance =
+            (N - 1 - empty_index / N) + (N - 1 - empty_index % N);
+        return parity == (blank_distance & 1);
+    }
+
+    static bool is_solvable(const StateOf<N>& state) { return is_solvable(pack(state)); }
+
+    /**
+     * @brief Returns a copy of the state with the tiles at two indices swapped.
+     */
+    static PackedState swap_tiles(PackedState state, int a, int b) {
+        // XOR-swap of the two nibbles: x holds tile_a ^ tile_b, and applying
+        // it at both positions exchanges them without any intermediate copy.
+        PackedState x = ((state >> (4 * a)) ^ (state >> (4 * b))) & 0xF;
+        return state ^ (x << (4 * a)) ^ (x << (4 * b));
+    }
+
+private:
+    PackedState goal_state_;
+    const PatternDatabase* pdb_ = nullptr; // Not owned; see set_pattern_database()
+    double weight_ = 1.0;                  // Weighted A* weight; see set_weight()
+    std::uint64_t deadline_micros_ = 0;    // Per-solve budget; see set_deadline_micros()
+    TranspositionCache tt_cache_;          // Cross-call state -> exact distance cache
+    SearchNodeArena arena_; // Node pool for solve_with_a_star, reused across calls
+
+    // Open list, also reused across calls (cleared, not deallocated). A
+    // 4-ary heap of 32-bit node indices with decrease-key: duplicates never
+    // enter the heap, so no stale entries are ever popped. The ranked mode
+    // shares it, keyed by permutation rank instead of arena index.
+    DaryHeap open_heap_;
+
+    // Flat bookkeeping for solve_with_ranked_a_star, indexed by Lehmer
+    // rank: per-state g-score and the blank's position in the parent state.
+    // 0xFF means "never seen" in both. Empty until the mode is first used.
+    std::vector<std::uint8_t> ranked_g_;
+    std::vector<std::uint8_t> ranked_parent_;
+
+    // Sentinel return values for ida_search: the goal was reached, or no
+    // f-score exceeded the bound (the reachable space is exhausted).
+    static constexpr int kFound = -1;
+    static constexpr int kNoSolution = std::numeric_limits<int>::max();
+
+    // Fixed-point scale for heap keys, so fractional weights still order
+    // correctly in the integer heap. f-scores stay below ~100, so scaled
+    // keys fit an int with room to spare; at w = 1 the scaled key orders
+    // identically to the plain g + h.
+    static constexpr int kWeightScale = 256;
+
+    /**
+     * @brief Heap key for a node: fixed-point f = g + w*h.
      */
-    Path reconstruct_move_path(
-        const std::unordered_map<State, std::pair<State, Move>, ArrayHasher>& came_from,
-        State current_state
-    ) const {
+    int f_key(int g, int h) const {
+        return g * kWeightScale + static_cast<int>(weight_ * h * kWeightScale + 0.5);
+    }
+
+    /**
+     * @brief One bounded depth-first pass of IDA*.
+     *
+     * Explores all paths whose f-score stays within `bound`. On success the
+     * winning moves are left in `path`; otherwise returns the minimum
+     * f-score that exceeded the bound, which becomes the next iteration's
+     * bound.
+     */
+    int ida_search(PackedState state, int g, int bound, int prev_empty_index, Path& path) {
+        int f = g + heuristic(state);
+        if (f > bound) {
+            return f;
+        }
+        if (state == goal_state_) {
+            return kFound;
+        }
+
+        int min_exceeding = kNoSolution;
+        int empty_index = find_empty(state);
+
+        const NeighborList& neighbors = kNeighbors[empty_index];
+        for (int k = 0; k < neighbors.count; ++k) {
+            const NeighborEntry& entry = neighbors.entries[k];
+            const int tile_index = entry.tile_index;
+            // Never undo the move we just made — the empty tile would
+            // slide straight back to where it came from.
+            if (tile_index == prev_empty_index) {
+                continue;
+            }
+
+            PackedState neighbor_state = swap_tiles(state, empty_index, tile_index);
+            path.push_back({entry.move_r, entry.move_c});
+            int result = ida_search(neighbor_state, g + 1, bound, empty_index, path);
+            if (result == kFound) {
+                return kFound;
+            }
+            path.pop_back();
+            if (result < min_exceeding) {
+                min_exceeding = result;
+            }
+        }
+        return min_exceeding;
+    }
+
+    /**
+     * @brief Manhattan distance contribution of a single tile at an index.
+     */
+    static int manhattan_for_tile(int tile, int index) {
+        int goal_index = tile - 1;
+        return std::abs(index / N - goal_index / N) +
+               std::abs(index % N - goal_index % N);
+    }
+
+    /**
+     * @brief Heuristic of a child state, derived from the parent's value.
+     *
+     * For Manhattan distance only the moved tile's contribution changes, so
+     * the child value is an O(1) adjustment of the parent's. Pattern
+     * database values are not decomposable per tile, so that mode re-looks
+     * the child up directly (itself just two table reads).
+     */
+    int child_heuristic(int parent_h, PackedState child_state,
+                        int moved_tile, int from_index, int to_index) const {
+        if constexpr (N == 3) {
+            if (pdb_ != nullptr) {
+                return pdb_->lookup(child_state);
+            }
+        }
+        return parent_h - manhattan_for_tile(moved_tile, from_index)
+                        + manhattan_for_tile(moved_tile, to_index);
+    }
+
+    /**
+     * @brief Follows cached next-move entries from a state to the goal.
+     *
+     * Entries are keyed by canonical state with the move in the canonical
+     * frame, so each step un-mirrors the move when the walked state is the
+     * mirrored twin. LRU eviction can break a chain mid-way; every link is
+     * therefore verified (present, and exactly one move closer) before the
+     * chain is trusted. On any break the hit is discarded and the search
+     * continues. `state` is the actual (unfolded) state of the hit node.
+     */
+    bool chain_from_cache(PackedState state, TranspositionCache::Entry entry, Path& tail) {
+        int remaining = entry.distance;
+        bool mirrored = symmetry::canonical<N>(state) != state;
+        while (remaining > 0) {
+            const int cell =
+                mirrored ? symmetry::mirror_cell<N>(entry.next_cell) : entry.next_cell;
+            tail.push_back({cell / N, cell % N});
+            state = swap_tiles(state, find_empty(state), cell);
+            --remaining;
+            if (state == goal_state_) {
+                return remaining == 0;
+            }
+            const PackedState key = symmetry::canonical<N>(state);
+            mirrored = (key != state);
+            const TranspositionCache::Entry* next = tt_cache_.find(key);
+            if (next == nullptr || next->distance != remaining) {
+                tail.clear();
+                return false;
+            }
+            entry = *next;
+        }
+        return state == goal_state_;
+    }
+
+    /**
+     * @brief Records every suffix of a completed optimal path in the cache.
+     *
+     * Keys are canonical states, with each move translated into the
+     * canonical frame, so a cached solve also covers every state's
+     * diagonal mirror at no extra capacity cost.
+     */
+    void update_transposition_cache(PackedState state, const Path& path) {
+        if (tt_cache_.capacity() == 0) {
+            return;
+        }
+        const int total = static_cast<int>(path.size());
+        for (int i = 0; i < total; ++i) {
+            const int cell = path[i].first * N + path[i].second;
+            const PackedState key = symmetry::canonical<N>(state);
+            const int stored_cell =
+                key != state ? symmetry::mirror_cell<N>(cell) : cell;
+            tt_cache_.insert(key, static_cast<std::uint8_t>(total - i),
+                             static_cast<std::uint8_t>(stored_cell));
+            state = swap_tiles(state, find_empty(state), cell);
+        }
+    }
+
+    /**
+     * @brief Reconstructs the ranked-mode path by undoing slides.
+     *
+     * A child's blank sits exactly where the slid tile came from, so each
+     * recorded parent-blank position is enough to both name the move and
+     * step back to the parent state.
+     */
+    Path reconstruct_ranked_path(PackedState state, std::uint32_t rank_value) const {
+        Path total_path;
+        while (ranked_parent_[rank_value] != 0xFF) {
+            const int empty_index = find_empty(state); // The slid tile's old cell
+            total_path.push_back({empty_index / N, empty_index % N});
+            state = swap_tiles(state, empty_index, ranked_parent_[rank_value]);
+            rank_value = permutation_rank::rank(state);
+        }
+        std::reverse(total_path.begin(), total_path.end());
+        return total_path;
+    }
+
+    /**
+     * @brief Reconstructs the path of moves by walking arena parent links.
+     */
+    Path reconstruct_move_path(std::uint32_t node_index) const {
         Path total_path;
-        while (came_from.count(current_state)) {
-            const auto& record = came_from.at(current_state);
-            total_path.push_back(record.second);
-            current_state = record.first;
+        while (arena_[node_index].parent != SearchNodeArena::kInvalidIndex) {
+            const SearchNode& node = arena_[node_index];
+            total_path.push_back({node.move_r, node.move_c});
+            node_index = node.parent;
         }
         std::reverse(total_path.begin(), total_path.end());
         return total_path;
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,126 @@
+// src/SearchNodeArena.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <algorithm>  // For std::fill
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Arena-Allocated Search Node Store ---
+// A* bookkeeping used to live in three separate hash containers (g_score,
+// came_from, open_set_hash), each hashed and probed independently per
+// neighbor, each allocating per node. Here everything about a node sits in
+// one 24-byte record inside a contiguous pool, and a single open-addressing
+// table maps packed state -> node index. One probe per neighbor, zero
+// per-node heap allocations, and parent links are 32-bit indices instead of
+// 8-byte state copies.
+
+struct SearchNode {
+    std::uint64_t state;   // Packed state (4 bits per tile)
+    std::int32_t g;        // Cost from the start node
+    std::int32_t h;        // Cached heuristic value
+    std::uint32_t parent;  // Arena index of the parent, kInvalidIndex for the root
+    std::uint8_t move_r;   // Board row of the tile that slid to reach this node
+    std::uint8_t move_c;   // Board column of that tile
+    bool in_open;          // Whether the node currently sits in the open heap
+    bool mirrored;         // True if the path reaches this state's diagonal mirror
+};
+
+class SearchNodeArena {
+public:
+    static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    SearchNodeArena() { rehash(kInitialBuckets); }
+
+    /**
+     * @brief Drops all nodes but keeps the allocated storage for reuse.
+     */
+    void clear() {
+        nodes_.clear();
+        std::fill(buckets_.begin(), buckets_.end(), kInvalidIndex);
+    }
+
+    std::size_t size() const { return nodes_.size(); }
+
+    SearchNode& operator[](std::uint32_t index) { return nodes_[index]; }
+    const SearchNode& operator[](std::uint32_t index) const { return nodes_[index]; }
+
+    /**
+     * @brief Looks up the node for a state.
+     * @return The node's arena index, or kInvalidIndex if the state is unknown.
+     */
+    std::uint32_t find(std::uint64_t state) const {
+        std::size_t slot = hash(state) & mask_;
+        while (buckets_[slot] != kInvalidIndex) {
+            if (nodes_[buckets_[slot]].state == state) {
+                return buckets_[slot];
+            }
+            slot = (slot + 1) & mask_;
+        }
+        return kInvalidIndex;
+    }
+
+    /**
+     * @brief Finds the node for a state, creating a fresh one if absent.
+     *
+     * A created node has only its state set; the caller fills in the rest.
+     * Note: creation may grow the pool, invalidating references (but not
+     * indices) handed out earlier.
+     *
+     * @param created Set to true if a new node was allocated.
+     */
+    std::uint32_t intern(std::uint64_t state, bool& created) {
+        std::size_t slot = hash(state) & mask_;
+        while (buckets_[slot] != kInvalidIndex) {
+            if (nodes_[buckets_[slot]].state == state) {
+                created = false;
+                return buckets_[slot];
+            }
+            slot = (slot + 1) & mask_;
+        }
+
+        std::uint32_t index = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.push_back(SearchNode{state, 0, 0, kInvalidIndex, 0, 0, false, false});
+        buckets_[slot] = index;
+        created = true;
+
+        // Keep the load factor below ~2/3 so probe chains stay short.
+        if (nodes_.size() * 3 > buckets_.size() * 2) {
+            rehash(buckets_.size() * 2);
+        }
+        return index;
+    }
+
+private:
+    static constexpr std::size_t kInitialBuckets = 1024; // Must be a power of two
+
+    /**
+     * @brief Mixes the packed state into a well-distributed hash.
+     *
+     * Packed states only vary in their low 36 bits and differ by single
+     * nibbles between neighbors, so a finalizer-style mix (splitmix64) is
+     * needed for open addressing to probe well.
+     */
+    static std::size_t hash(std::uint64_t state) {
+        state += 0x9e3779b97f4a7c15ull;
+        state = (state ^ (state >> 30)) * 0xbf58476d1ce4e5b9ull;
+        state = (state ^ (state >> 27)) * 0x94d049bb133111ebull;
+        return static_cast<std::size_t>(state ^ (state >> 31));
+    }
+
+    void rehash(std::size_t new_bucket_count) {
+        buckets_.assign(new_bucket_count, kInvalidIndex);
+        mask_ = new_bucket_count - 1;
+        for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+            std::size_t slot = hash(nodes_[i].state) & mask_;
+            while (buckets_[slot] != kInvalidIndex) {
+                slot = (slot + 1) & mask_;
+            }
+            buckets_[slot] = i;
+        }
+    }
+
+    std::vector<SearchNode> nodes_;      // The contiguous node pool
+    std::vector<std::uint32_t> buckets_; // Open-addressing index into nodes_
+    std::size_t mask_ = 0;
+};
@@ -0,0 +1,185 @@
+// src/SimdHeuristic.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define PUZZLE_SIMD_X86 1
+#endif
+
+// --- Vectorized Batch Manhattan Distance ---
+// Bulk workloads (the database builder, batch evaluation from Python) need
+// heuristics for thousands of packed states at a time, and the work is
+// embarrassingly data-parallel. A packed state's 16 nibbles expand into the
+// 16 byte lanes of an SSE register; two pshufb lookups map each tile to its
+// goal row and column, and the per-position current row/column are
+// constants — so one state's full Manhattan distance is a handful of byte
+// ops plus a horizontal sum. The AVX2 path runs two states per iteration.
+// Dispatch picks AVX2, SSSE3 or scalar at runtime, so the module still runs
+// on any x86-64 (and any other architecture via the scalar path).
+
+namespace simd_heuristic {
+
+/**
+ * @brief Scalar reference: Manhattan distance of one packed state.
+ */
+inline int manhattan_scalar(std::uint64_t state, int grid) {
+    const int cells = grid * grid;
+    int distance = 0;
+    for (int i = 0; i < cells; ++i) {
+        const int tile = static_cast<int>((state >> (4 * i)) & 0xF);
+        if (tile != 0) {
+            const int goal = tile - 1;
+            const int dr = i / grid - goal / grid;
+            const int dc = i % grid - goal % grid;
+            distance += (dr < 0 ? -dr : dr) + (dc < 0 ? -dc : dc);
+        }
+    }
+    return distance;
+}
+
+#ifdef PUZZLE_SIMD_X86
+
+namespace detail {
+
+// Byte lane k holds the property of board position k (or of tile k for the
+// goal tables). Tile 0 (the blank) gets zeros; its lanes are masked anyway.
+struct Tables {
+    alignas(16) std::uint8_t cur_row[16];
+    alignas(16) std::uint8_t cur_col[16];
+    alignas(16) std::uint8_t goal_row[16];
+    alignas(16) std::uint8_t goal_col[16];
+};
+
+inline Tables make_tables(int grid) {
+    Tables t{};
+    for (int i = 0; i < 16; ++i) {
+        t.cur_row[i] = static_cast<std::uint8_t>((i / grid) < grid ? i / grid : 0);
+        t.cur_col[i] = static_cast<std::uint8_t>(i % grid);
+        // Goal position of tile i is cell i-1; tile 0 is the blank.
+        const int goal = (i == 0) ? 0 : i - 1;
+        t.goal_row[i] = static_cast<std::uint8_t>(goal / grid);
+        t.goal_col[i] = static_cast<std::uint8_t>(goal % grid);
+    }
+    return t;
+}
+
+inline const Tables& tables_for(int grid) {
+    static const Tables grid3 = make_tables(3);
+    static const Tables grid4 = make_tables(4);
+    return grid == 3 ? grid3 : grid4;
+}
+
+__attribute__((target("ssse3")))
+inline int manhattan_one_ssse3(std::uint64_t state, const Tables& t) {
+    // Expand the 16 nibbles into 16 byte lanes.
+    const __m128i raw = _mm_cvtsi64_si128(static_cast<long long>(state));
+    const __m128i hi = _mm_srli_epi16(raw, 4);
+    const __m128i tiles =
+        _mm_and_si128(_mm_unpacklo_epi8(raw, hi), _mm_set1_epi8(0x0F));
+
+    const __m128i goal_r =
+        _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(t.goal_row)), tiles);
+    const __m128i goal_c =
+        _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(t.goal_col)), tiles);
+    const __m128i cur_r = _mm_load_si128(reinterpret_cast<const __m128i*>(t.cur_row));
+    const __m128i cur_c = _mm_load_si128(reinterpret_cast<const __m128i*>(t.cur_col));
+
+    // |a - b| on unsigned bytes: max(a,b) - min(a,b).
+    const __m128i dr = _mm_sub_epi8(_mm_max_epu8(cur_r, goal_r), _mm_min_epu8(cur_r, goal_r));
+    const __m128i dc = _mm_sub_epi8(_mm_max_epu8(cur_c, goal_c), _mm_min_epu8(cur_c, goal_c));
+
+    // Zero out the blank's lane, then sum all byte lanes.
+    const __m128i blank = _mm_cmpeq_epi8(tiles, _mm_setzero_si128());
+    const __m128i dist = _mm_andnot_si128(blank, _mm_add_epi8(dr, dc));
+    const __m128i sums = _mm_sad_epu8(dist, _mm_setzero_si128());
+    return _mm_extract_epi16(sums, 0) + _mm_extract_epi16(sums, 4);
+}
+
+__attribute__((target("avx2")))
+inline void manhattan_pair_avx2(const std::uint64_t* states, std::int32_t* out,
+                                const Tables& t) {
+    // Same recipe as the SSSE3 path, with one state per 128-bit lane.
+    const __m256i raw = _mm256_set_epi64x(
+        0, static_cast<long long>(states[1]), 0, static_cast<long long>(states[0]));
+    const __m256i hi = _mm256_srli_epi16(raw, 4);
+    const __m256i tiles =
+        _mm256_and_si256(_mm256_unpacklo_epi8(raw, hi), _mm256_set1_epi8(0x0F));
+
+    const __m256i goal_row_tab = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(t.goal_row)));
+    const __m256i goal_col_tab = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(t.goal_col)));
+    const __m256i cur_r = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(t.cur_row)));
+    const __m256i cur_c = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(t.cur_col)));
+
+    const __m256i goal_r = _mm256_shuffle_epi8(goal_row_tab, tiles);
+    const __m256i goal_c = _mm256_shuffle_epi8(goal_col_tab, tiles);
+    const __m256i dr =
+        _mm256_sub_epi8(_mm256_max_epu8(cur_r, goal_r), _mm256_min_epu8(cur_r, goal_r));
+    const __m256i dc =
+        _mm256_sub_epi8(_mm256_max_epu8(cur_c, goal_c), _mm256_min_epu8(cur_c, goal_c));
+
+    const __m256i blank = _mm256_cmpeq_epi8(tiles, _mm256_setzero_si256());
+    const __m256i dist = _mm256_andnot_si256(blank, _mm256_add_epi8(dr, dc));
+    const __m256i sums = _mm256_sad_epu8(dist, _mm256_setzero_si256());
+
+    out[0] = _mm256_extract_epi16(sums, 0) + _mm256_extract_epi16(sums, 4);
+    out[1] = _mm256_extract_epi16(sums, 8) + _mm256_extract_epi16(sums, 12);
+}
+
+__attribute__((target("avx2")))
+inline void manhattan_batch_avx2(const std::uint64_t* states, std::int32_t* out,
+                                 std::size_t count, const Tables& t) {
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        manhattan_pair_avx2(states + i, out + i, t);
+    }
+    for (; i < count; ++i) {
+        out[i] = manhattan_one_ssse3(states[i], t);
+    }
+}
+
+__attribute__((target("ssse3")))
+inline void manhattan_batch_ssse3(const std::uint64_t* states, std::int32_t* out,
+                                  std::size_t count, const Tables& t) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = manhattan_one_ssse3(states[i], t);
+    }
+}
+
+} // namespace detail
+
+#endif // PUZZLE_SIMD_X86
+
+/**
+ * @brief Manhattan distances for a batch of packed states.
+ *
+ * Picks the widest instruction set the CPU supports, decided once per
+ * process. `grid` must be 3 or 4 and applies to the whole batch.
+ */
+inline void manhattan_batch(const std::uint64_t* states, std::int32_t* out,
+                            std::size_t count, int grid) {
+#ifdef PUZZLE_SIMD_X86
+    static const bool have_avx2 = __builtin_cpu_supports("avx2");
+    static const bool have_ssse3 = __builtin_cpu_supports("ssse3");
+    const detail::Tables& t = detail::tables_for(grid);
+    if (have_avx2) {
+        detail::manhattan_batch_avx2(states, out, count, t);
+        return;
+    }
+    if (have_ssse3) {
+        detail::manhattan_batch_ssse3(states, out, count, t);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = manhattan_scalar(states[i], grid);
+    }
+}
+
+} // namespace simd_heuristic
@@ -0,0 +1,418 @@
+// src/SolutionStore.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <algorithm>  // For std::lower_bound / std::sort
+#include <cstdint>
+#include <cstdio>     // For std::fopen / std::fwrite
+#include <cstring>    // For std::memcmp
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// POSIX memory mapping — like the pattern database, the store is mapped
+// read-only and shared so all worker processes reuse one physical copy.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h> // AVX2 path of the nearest-neighbor scan
+#endif
+
+#include "MoveEncoding.hpp" // 2-bit direction codec for the path section
+#include "PuzzleSolver.hpp" // For PackedState, Move, Path
+
+// --- Native Solution Store ---
+// A compact, mmap-able replacement for the pickled solution dictionaries and
+// the FAISS index. Everything read-side lives in the file in its final,
+// position-independent shape (sorted arrays addressed by offsets, no
+// pointers), so a worker attaches with one mmap in O(1) — no
+// deserialization, no per-worker copy — and every process on the machine
+// shares the same physical pages through the page cache.
+//
+// File layout:
+//   8 bytes   magic "PUZSTOR3"
+//   4 bytes   grid size (3 or 4)
+//   4 bytes   reserved (zero)
+//   8 bytes   entry count
+//   states    uint64[count], packed states sorted ascending; exact lookup
+//             is one binary search here, and the nearest-neighbor scan
+//             streams this column straight out of the mapping at full
+//             memory bandwidth
+//   entries   PathEntry[count], same order as the state column
+//   paths     packed 2-bit move directions (see MoveEncoding.hpp), four
+//             moves per byte, at each entry's offset
+class SolutionStore {
+public:
+    static constexpr char kMagic[8] = {'P', 'U', 'Z', 'S', 'T', 'O', 'R', '3'};
+
+    struct PathEntry {
+        std::uint64_t path_offset; // Byte offset of the path, from the start of the path section
+        std::uint32_t path_len;    // Number of moves
+        std::uint32_t reserved;    // Keeps the entry 8-byte aligned; written as zero
+    };
+    static_assert(sizeof(PathEntry) == 16, "On-disk path entry must be packed");
+
+    SolutionStore() = default;
+
+    SolutionStore(const SolutionStore&) = delete;
+    SolutionStore& operator=(const SolutionStore&) = delete;
+
+    ~SolutionStore() { close(); }
+
+    /**
+     * @brief Memory-maps a solution store file.
+     * @throws std::runtime_error if the file is missing or malformed.
+     */
+    void load(const std::string& path) {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open solution store file: " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderSize)) {
+            ::close(fd);
+            throw std::runtime_error("Solution store file is truncated: " + path);
+        }
+
+        void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps the file alive; the fd is no longer needed.
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("mmap failed for solution store file: " + path);
+        }
+
+        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(mapping);
+        if (std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0) {
+            const bool old_format = std::memcmp(bytes, "PUZSTOR", 7) == 0;
+            munmap(mapping, st.st_size);
+            if (old_format) {
+                throw std::runtime_error(
+                    "Solution store file uses an old format version; "
+                    "rebuild it with build_db.py: " + path);
+            }
+            throw std::runtime_error("Solution store file has wrong magic: " + path);
+        }
+
+        std::uint32_t grid_size;
+        std::uint64_t count;
+        std::memcpy(&grid_size, bytes + 8, sizeof(grid_size));
+        std::memcpy(&count, bytes + 16, sizeof(count));
+
+        const std::uint64_t index_bytes =
+            count * (sizeof(std::uint64_t) + sizeof(PathEntry));
+        if (static_cast<std::uint64_t>(st.st_size) < kHeaderSize + index_bytes) {
+            munmap(mapping, st.st_size);
+            throw std::runtime_error("Solution store index exceeds file size: " + path);
+        }
+
+        mapping_ = mapping;
+        mapping_size_ = st.st_size;
+        grid_size_ = static_cast<int>(grid_size);
+        count_ = count;
+        states_ = reinterpret_cast<const std::uint64_t*>(bytes + kHeaderSize);
+        entries_ = reinterpret_cast<const PathEntry*>(
+            bytes + kHeaderSize + count * sizeof(std::uint64_t));
+        paths_ = bytes + kHeaderSize + index_bytes;
+        paths_size_ = st.st_size - kHeaderSize - index_bytes;
+    }
+
+    bool is_loaded() const { return mapping_ != nullptr; }
+    std::uint64_t size() const { return count_; }
+    int grid_size() const { return grid_size_; }
+
+    /**
+     * @brief Exact-match lookup of a stored solution path.
+     *
+     * Decodes the packed 2-bit directions back into (row, col) moves, so
+     * callers see the same Path type as the solvers return.
+     * @return The move path if the state is in the store, otherwise std::nullopt.
+     */
+    std::optional<Path> lookup(PackedState state) const {
+        const PathEntry* entry = find(state);
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+        return move_encoding::decode(state, paths_ + entry->path_offset,
+                                     entry->path_len, grid_size_);
+    }
+
+    /**
+     * @brief Exact-match lookup returning the path in its encoded form.
+     *
+     * For callers that want the compact representation as-is (a quarter
+     * byte per move) — e.g. to ship over the wire or cache in bulk —
+     * without paying for decoding. Decode with move_encoding::decode()
+     * (or the decode_moves binding) using the same state.
+     * @return (encoded bytes, move count), or std::nullopt on a miss.
+     */
+    std::optional<std::pair<std::vector<std::uint8_t>, std::uint32_t>>
+    lookup_compact(PackedState state) const {
+        const PathEntry* entry = find(state);
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+        const std::uint8_t* begin = paths_ + entry->path_offset;
+        return std::make_pair(
+            std::vector<std::uint8_t>(begin,
+                                      begin + move_encoding::encoded_size(entry->path_len)),
+            entry->path_len);
+    }
+
+    bool contains(PackedState state) const { return find(state) != nullptr; }
+
+    /**
+     * @brief Hamming distance between two packed states, in board cells.
+     *
+     * Counts the cells whose tiles differ. One XOR leaves a non-zero nibble
+     * exactly at the differing cells; folding each nibble's bits into its
+     * lowest bit turns the count into a single popcount.
+     */
+    static int hamming_distance(PackedState a, PackedState b) {
+        std::uint64_t x = a ^ b;
+        x = (x | (x >> 1) | (x >> 2) | (x >> 3)) & 0x1111111111111111ull;
+        return __builtin_popcountll(x);
+    }
+
+    /**
+     * @brief The k stored states most similar to a query state.
+     *
+     * Replaces the FAISS flat-L2 search: Hamming distance over board cells
+     * is the natural similarity for permutation states (how many tiles are
+     * on different cells), and a linear scan over the packed 64-bit states
+     * in the index beats an approximate-vector detour at this scale. The
+     * AVX2 path distances four entries per iteration — a few instructions
+     * per state, so millions of entries scan in about a millisecond — with
+     * the scalar loop covering other machines.
+     *
+     * @return Up to k (state, distance) pairs, ascending by distance
+     *         (ties broken by packed state value, so results are stable).
+     */
+    std::vector<std::pair<PackedState, int>> top_k_nearest(PackedState query, int k) const {
+        if (!is_loaded() || k <= 0 || count_ == 0) {
+            return {};
+        }
+        const std::size_t take = std::min<std::size_t>(k, count_);
+
+        // Distances are computed a fixed-size chunk at a time and filtered
+        // against the current k-th best; once the result array fills up,
+        // almost every entry fails that compare and the scan runs at the
+        // kernel's speed. The index is sorted by state and skipped entries
+        // tie at worst with kept ones, so equal distances resolve to the
+        // smallest states without any extra bookkeeping.
+        std::vector<std::pair<PackedState, int>> best; // Sorted by (distance, state)
+        best.reserve(take);
+        int worst = 0x7FFFFFFF;
+
+        constexpr std::size_t kChunk = 1024;
+        std::int32_t distances[kChunk];
+#if defined(__x86_64__) || defined(_M_X64)
+        static const bool have_avx2 = __builtin_cpu_supports("avx2");
+#endif
+        for (std::uint64_t base = 0; base < count_; base += kChunk) {
+            const std::uint64_t n = std::min<std::uint64_t>(kChunk, count_ - base);
+            int chunk_min = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+            if (have_avx2) {
+                chunk_min = scan_distances_avx2(states_ + base, n, query, distances);
+            } else
+#endif
+            {
+                chunk_min = 0x7FFFFFFF;
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    distances[i] = hamming_distance(states_[base + i], query);
+                    chunk_min = std::min(chunk_min, distances[i]);
+                }
+            }
+            // Once the result is full, a chunk whose best distance cannot
+            // displace the current k-th best is skipped wholesale — on a
+            // large store that is almost every chunk.
+            if (best.size() == take && chunk_min >= worst) {
+                continue;
+            }
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const int dist = distances[i];
+                if (best.size() < take) {
+                    // Still filling: insert unconditionally, keep sorted.
+                    const std::pair<PackedState, int> entry{states_[base + i], dist};
+                    const auto pos = std::upper_bound(
+                        best.begin(), best.end(), dist,
+                        [](int d, const auto& e) { return d < e.second; });
+                    best.insert(pos, entry);
+                    worst = best.back().second;
+                } else if (dist < worst) {
+                    const auto pos = std::upper_bound(
+                        best.begin(), best.end(), dist,
+                        [](int d, const auto& e) { return d < e.second; });
+                    best.insert(pos, {states_[base + i], dist});
+                    best.pop_back();
+                    worst = best.back().second;
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Writes a store file from (packed state, move path) pairs.
+     *
+     * Entries are sorted by packed state here, so readers can binary-search
+     * the index directly out of the mapping. Duplicate states keep their
+     * first occurrence.
+     */
+    static void write_file(const std::string& path, int grid_size,
+                           std::vector<std::pair<PackedState, Path>> entries) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        entries.erase(std::unique(entries.begin(), entries.end(),
+                                  [](const auto& a, const auto& b) {
+                                      return a.first == b.first;
+                                  }),
+                      entries.end());
+
+        std::vector<std::uint64_t> states(entries.size());
+        std::vector<PathEntry> index(entries.size());
+        std::vector<std::uint8_t> path_bytes;
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            const Path& moves = entries[i].second;
+            states[i] = entries[i].first;
+            index[i] = {path_bytes.size(), static_cast<std::uint32_t>(moves.size()), 0};
+            const std::vector<std::uint8_t> encoded =
+                move_encoding::encode(entries[i].first, moves, grid_size);
+            path_bytes.insert(path_bytes.end(), encoded.begin(), encoded.end());
+        }
+
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            throw std::runtime_error("Could not open output file: " + path);
+        }
+        const std::uint32_t grid = static_cast<std::uint32_t>(grid_size);
+        const std::uint32_t reserved = 0;
+        const std::uint64_t count = entries.size();
+        bool ok = std::fwrite(kMagic, 1, sizeof(kMagic), f) == sizeof(kMagic) &&
+                  std::fwrite(&grid, sizeof(grid), 1, f) == 1 &&
+                  std::fwrite(&reserved, sizeof(reserved), 1, f) == 1 &&
+                  std::fwrite(&count, sizeof(count), 1, f) == 1 &&
+                  (states.empty() ||
+                   std::fwrite(states.data(), sizeof(std::uint64_t), states.size(), f) ==
+                       states.size()) &&
+                  (index.empty() ||
+                   std::fwrite(index.data(), sizeof(PathEntry), index.size(), f) == index.size()) &&
+                  (path_bytes.empty() ||
+                   std::fwrite(path_bytes.data(), 1, path_bytes.size(), f) == path_bytes.size());
+        std::fclose(f);
+        if (!ok) {
+            throw std::runtime_error("Short write while saving solution store: " + path);
+        }
+    }
+
+private:
+    static constexpr std::size_t kHeaderSize = 24;
+
+#if defined(__x86_64__) || defined(_M_X64)
+    /**
+     * @brief AVX2 kernel of top_k_nearest: Hamming distances of four packed
+     *        states against the query per iteration.
+     *
+     * Same XOR-and-fold recipe as the scalar hamming_distance, in 64-bit
+     * lanes; the final per-lane popcount splits each flag nibble's two
+     * relevant bits into separate bytes and horizontally sums them with
+     * psadbw.
+     *
+     * @return The smallest distance in the chunk, so the caller can skip
+     *         its per-entry filtering pass when nothing here qualifies.
+     */
+    __attribute__((target("avx2")))
+    static int scan_distances_avx2(const std::uint64_t* states_base, std::uint64_t count,
+                                   std::uint64_t query, std::int32_t* out) {
+        const __m256i q = _mm256_set1_epi64x(static_cast<long long>(query));
+        const __m256i nibble_low = _mm256_set1_epi64x(0x1111111111111111ll);
+        const __m256i byte_low = _mm256_set1_epi8(0x01);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i running_min = _mm256_set1_epi64x(0x7FFFFFFF);
+        std::uint64_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m256i states = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(states_base + i));
+            __m256i x = _mm256_xor_si256(states, q);
+            x = _mm256_or_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 1)),
+                                _mm256_or_si256(_mm256_srli_epi64(x, 2),
+                                                _mm256_srli_epi64(x, 3)));
+            x = _mm256_and_si256(x, nibble_low);
+            // Each byte now holds a flag in bit 0 and one in bit 4; add the
+            // two, then psadbw sums the eight bytes of each lane.
+            const __m256i per_byte = _mm256_add_epi8(
+                _mm256_and_si256(x, byte_low),
+                _mm256_and_si256(_mm256_srli_epi64(x, 4), byte_low));
+            const __m256i sums = _mm256_sad_epu8(per_byte, zero);
+            // psadbw leaves each distance in the low 32 bits of its lane,
+            // so a 32-bit min is safe for the running chunk minimum.
+            running_min = _mm256_min_epi32(running_min, sums);
+            alignas(32) std::int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+            out[i] = static_cast<std::int32_t>(lanes[0]);
+            out[i + 1] = static_cast<std::int32_t>(lanes[1]);
+            out[i + 2] = static_cast<std::int32_t>(lanes[2]);
+            out[i + 3] = static_cast<std::int32_t>(lanes[3]);
+        }
+        alignas(32) std::int64_t min_lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(min_lanes), running_min);
+        int chunk_min = static_cast<int>(std::min(std::min(min_lanes[0], min_lanes[1]),
+                                                  std::min(min_lanes[2], min_lanes[3])));
+        for (; i < count; ++i) {
+            out[i] = hamming_distance(states_base[i], query);
+            chunk_min = std::min(chunk_min, static_cast<int>(out[i]));
+        }
+        return chunk_min;
+    }
+#endif
+
+    const PathEntry* find(PackedState state) const {
+        if (!is_loaded()) {
+            return nullptr;
+        }
+        const std::uint64_t* end = states_ + count_;
+        const std::uint64_t* it = std::lower_bound(states_, end, state);
+        if (it == end || *it != state) {
+            return nullptr;
+        }
+        const PathEntry* entry = entries_ + (it - states_);
+        // A truncated or corrupted file can carry a plausible header and
+        // index; checked here (not as an O(n) pass in load()) so attaching
+        // stays O(1). Written subtraction-side to dodge offset overflow.
+        if (entry->path_offset > paths_size_ ||
+            move_encoding::encoded_size(entry->path_len) >
+                paths_size_ - entry->path_offset) {
+            throw std::runtime_error(
+                "Solution store path entry points past the end of the file; "
+                "the store is corrupted — rebuild it with build_db.py");
+        }
+        return entry;
+    }
+
+    void close() {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapping_size_);
+            mapping_ = nullptr;
+            mapping_size_ = 0;
+            states_ = nullptr;
+            entries_ = nullptr;
+            paths_ = nullptr;
+            count_ = 0;
+        }
+    }
+
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    int grid_size_ = 0;
+    std::uint64_t count_ = 0;
+    const std::uint64_t* states_ = nullptr; // Sorted state column, in the mapping
+    const PathEntry* entries_ = nullptr;    // Path locations, same order
+    const std::uint8_t* paths_ = nullptr;
+    std::uint64_t paths_size_ = 0;
+};
@@ -0,0 +1,84 @@
+// src/Symmetry.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <array>
+#include <cstdint>
+
+// --- Diagonal Reflection Symmetry ---
+// Reflecting the board across its main diagonal, while relabeling every
+// tile to the one whose goal cell is the reflection of its own, is an
+// automorphism of the puzzle graph that fixes the goal (the blank's goal
+// cell sits on the diagonal for both grids). A state and its mirror are
+// therefore always the same distance from the goal, and mirroring an
+// optimal path for one yields an optimal path for the other. Folding each
+// {state, mirror} pair onto one canonical representative — the smaller
+// packed value — halves the effective state space of every structure that
+// is keyed by state: the A* closed set, the transposition cache and the
+// endgame tablebase all cover twice the states per entry.
+namespace symmetry {
+
+namespace detail {
+
+// σ: cell index reflected across the main diagonal, (r, c) -> (c, r).
+template <int N>
+constexpr std::array<std::uint8_t, N * N> make_cell_map() {
+    std::array<std::uint8_t, N * N> map{};
+    for (int i = 0; i < N * N; ++i) {
+        map[i] = static_cast<std::uint8_t>((i % N) * N + i / N);
+    }
+    return map;
+}
+
+// ρ: the tile relabeling conjugate to σ. Tile t's goal cell is t-1, so the
+// mirrored board is goal-preserving exactly when tile t becomes the tile
+// whose goal cell is σ(t-1). The blank maps to itself.
+template <int N>
+constexpr std::array<std::uint8_t, 16> make_tile_map() {
+    constexpr auto cell = make_cell_map<N>();
+    std::array<std::uint8_t, 16> map{};
+    map[0] = 0;
+    for (int t = 1; t < N * N; ++t) {
+        map[t] = static_cast<std::uint8_t>(cell[t - 1] + 1);
+    }
+    return map;
+}
+
+} // namespace detail
+
+/**
+ * @brief The reflected cell index: (r, c) -> (c, r).
+ */
+template <int N>
+inline int mirror_cell(int cell) {
+    constexpr auto kCellMap = detail::make_cell_map<N>();
+    return kCellMap[cell];
+}
+
+/**
+ * @brief The diagonal mirror of a packed state.
+ *
+ * An involution: mirror(mirror(s)) == s, and mirror(goal) == goal.
+ */
+template <int N>
+inline std::uint64_t mirror(std::uint64_t state) {
+    constexpr auto kCellMap = detail::make_cell_map<N>();
+    constexpr auto kTileMap = detail::make_tile_map<N>();
+    std::uint64_t out = 0;
+    for (int i = 0; i < N * N; ++i) {
+        const std::uint64_t tile = (state >> (4 * i)) & 0xF;
+        out |= static_cast<std::uint64_t>(kTileMap[tile]) << (4 * kCellMap[i]);
+    }
+    return out;
+}
+
+/**
+ * @brief The canonical representative of a state's {s, mirror(s)} pair:
+ *        the lexicographically (numerically) smaller packed value.
+ */
+template <int N>
+inline std::uint64_t canonical(std::uint64_t state) {
+    const std::uint64_t mirrored = mirror<N>(state);
+    return mirrored < state ? mirrored : state;
+}
+
+} // namespace symmetry
@@ -0,0 +1,263 @@
+// src/Tablebase.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <cstdint>
+#include <cstdio>     // For std::fopen / std::fwrite
+#include <cstring>    // For std::memcmp
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// POSIX memory mapping, same pattern as the other read-side structures.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Metrics.hpp"          // Process-wide counters for solve accounting
+#include "PermutationRank.hpp" // Lehmer rank shared with the ranked A* mode
+#include "PuzzleSolver.hpp"     // For PackedState, Move, Path
+#include "Symmetry.hpp"         // Diagonal-reflection canonicalization
+
+// --- Full 8-Puzzle Endgame Tablebase ---
+// The 3x3 puzzle has 9! = 362,880 permutations, half of them reachable. One
+// breadth-first sweep outward from the goal visits every reachable state and
+// records, per state, the optimal first move (the board cell whose tile
+// should slide into the empty cell). With that, solving any 3x3 puzzle is a
+// walk of O(1) lookups — no search at all.
+//
+// States are indexed by their Lehmer code (permutation rank in [0, 9!)) and
+// each entry is one nibble: 0-8 = cell index of the tile to slide, 0xE =
+// already the goal, 0xF = unreachable. Two entries per byte gives a 177 KiB
+// table that is mmap-ed and shared across worker processes.
+//
+// The builder folds each state onto its diagonal-reflection canonical form
+// (see Symmetry.hpp), so only canonical ranks are populated and the BFS
+// visits half the space; lookups canonicalize the query and un-mirror the
+// returned move. The flat Lehmer indexing (and so the file size) is kept —
+// a quotient-space rank would need rank-select machinery worth more than
+// the 90 KiB it would save — which also keeps older full-table files
+// readable, their canonical entries being a superset of what is needed.
+class Tablebase {
+public:
+    static constexpr char kMagic[8] = {'P', 'U', 'Z', 'T', 'B', 'L', '1', '\0'};
+    static constexpr std::uint32_t kNumPermutations = permutation_rank::kNumPermutations;
+    static constexpr std::uint32_t kTableBytes = kNumPermutations / 2;
+
+    static constexpr std::uint8_t kEntryGoal = 0xE;
+    static constexpr std::uint8_t kEntryUnreachable = 0xF;
+
+    Tablebase() = default;
+
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+
+    ~Tablebase() { close(); }
+
+    /**
+     * @brief Memory-maps a tablebase file written by write_file().
+     * @throws std::runtime_error if the file is missing or malformed.
+     */
+    void load(const std::string& path) {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open tablebase file: " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 ||
+            st.st_size != static_cast<off_t>(sizeof(kMagic) + kTableBytes)) {
+            ::close(fd);
+            throw std::runtime_error("Tablebase file has unexpected size: " + path);
+        }
+
+        void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps the file alive; the fd is no longer needed.
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("mmap failed for tablebase file: " + path);
+        }
+
+        if (std::memcmp(mapping, kMagic, sizeof(kMagic)) != 0) {
+            munmap(mapping, st.st_size);
+            throw std::runtime_error("Tablebase file has wrong magic: " + path);
+        }
+
+        mapping_ = mapping;
+        mapping_size_ = st.st_size;
+        table_ = static_cast<const std::uint8_t*>(mapping) + sizeof(kMagic);
+    }
+
+    bool is_loaded() const { return mapping_ != nullptr; }
+
+    /**
+     * @brief Solves a 3x3 puzzle by chaining tablebase lookups.
+     *
+     * Each step reads one nibble and applies one slide, so the whole solve
+     * is proportional to the solution length (at most 31 steps).
+     */
+    std::optional<Path> solve(PackedState state) const {
+        metrics::registry().tablebase_solves_total.inc();
+        Path path;
+        while (true) {
+            // Entries exist for canonical states only and hold the move in
+            // the canonical frame; when the walked state is the mirrored
+            // twin, the move reflects back. The goal is its own mirror, so
+            // the termination test needs no unfolding.
+            const PackedState canon = symmetry::canonical<3>(state);
+            std::uint8_t entry = entry_at(rank(canon));
+            if (entry == kEntryGoal) {
+                return path;
+            }
+            if (entry == kEntryUnreachable) {
+                metrics::registry().tablebase_unsolvable_total.inc();
+                return std::nullopt;
+            }
+            const int tile_index =
+                canon != state ? symmetry::mirror_cell<3>(entry) : entry;
+            path.push_back({tile_index / 3, tile_index % 3});
+            state = apply_slide(state, tile_index);
+        }
+    }
+
+    /**
+     * @brief Lehmer-code rank of a packed 3x3 state in [0, 9!).
+     */
+    static std::uint32_t rank(PackedState state) {
+        return permutation_rank::rank(state);
+    }
+
+    /**
+     * @brief Builds the table with one BFS outward from the goal, over the
+     *        reflection-folded quotient graph.
+     *
+     * Expanding state s and generating neighbor n means n is one move
+     * further from the goal, and n's optimal first move is to slide the
+     * just-moved tile back — i.e. the tile now sitting where s's empty
+     * cell was. Neighbors fold onto their canonical form before the
+     * visited check, so each {state, mirror} pair is expanded once and the
+     * sweep does half the work; the reflection preserves distances, so the
+     * folded BFS still visits every class at its optimal depth.
+     */
+    static std::vector<std::uint8_t> build_table() {
+        std::vector<std::uint8_t> table(kTableBytes, 0xFF); // All-unreachable
+
+        const PackedState goal = pack_goal();
+        set_entry(table, rank(goal), kEntryGoal);
+
+        std::deque<PackedState> frontier{goal}; // Canonical representatives
+        while (!frontier.empty()) {
+            const PackedState state = frontier.front();
+            frontier.pop_front();
+
+            int empty_index = 0;
+            while (((state >> (4 * empty_index)) & 0xF) != 0) {
+                ++empty_index;
+            }
+
+            const int empty_r = empty_index / 3;
+            const int empty_c = empty_index % 3;
+            constexpr int offsets[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+            for (const auto& offset : offsets) {
+                const int r = empty_r + offset[0];
+                const int c = empty_c + offset[1];
+                if (r < 0 || r >= 3 || c < 0 || c >= 3) {
+                    continue;
+                }
+                const PackedState neighbor = apply_slide(state, r * 3 + c);
+                const PackedState canon = symmetry::canonical<3>(neighbor);
+                const std::uint32_t canon_rank = rank(canon);
+                if (entry_of(table, canon_rank) == kEntryUnreachable) {
+                    // From the neighbor, the optimal move slides the tile
+                    // that just moved (now at this state's empty cell);
+                    // stored in the canonical frame.
+                    const int cell = canon != neighbor
+                                         ? symmetry::mirror_cell<3>(empty_index)
+                                         : empty_index;
+                    set_entry(table, canon_rank, static_cast<std::uint8_t>(cell));
+                    frontier.push_back(canon);
+                }
+            }
+        }
+        return table;
+    }
+
+    /**
+     * @brief Builds the table and writes it (magic header + nibbles) to a file.
+     */
+    static void write_file(const std::string& path) {
+        std::vector<std::uint8_t> table = build_table();
+
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            throw std::runtime_error("Could not open output file: " + path);
+        }
+        bool ok = std::fwrite(kMagic, 1, sizeof(kMagic), f) == sizeof(kMagic) &&
+                  std::fwrite(table.data(), 1, table.size(), f) == table.size();
+        std::fclose(f);
+        if (!ok) {
+            throw std::runtime_error("Short write while saving tablebase: " + path);
+        }
+    }
+
+private:
+    void close() {
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mapping_size_);
+            mapping_ = nullptr;
+            mapping_size_ = 0;
+            table_ = nullptr;
+        }
+    }
+
+    static PackedState pack_goal() {
+        PackedState goal = 0;
+        for (int i = 0; i < 8; ++i) {
+            goal |= static_cast<PackedState>(i + 1) << (4 * i);
+        }
+        return goal;
+    }
+
+    /**
+     * @brief Slides the tile at `tile_index` into the (adjacent) empty cell.
+     */
+    static PackedState apply_slide(PackedState state, int tile_index) {
+        int empty_index = 0;
+        while (((state >> (4 * empty_index)) & 0xF) != 0) {
+            ++empty_index;
+        }
+        PackedState x = ((state >> (4 * empty_index)) ^ (state >> (4 * tile_index))) & 0xF;
+        return state ^ (x << (4 * empty_index)) ^ (x << (4 * tile_index));
+    }
+
+    std::uint8_t entry_at(std::uint32_t rank_value) const {
+        return entry_of_raw(table_, rank_value);
+    }
+
+    static std::uint8_t entry_of(const std::vector<std::uint8_t>& table,
+                                 std::uint32_t rank_value) {
+        return entry_of_raw(table.data(), rank_value);
+    }
+
+    static std::uint8_t entry_of_raw(const std::uint8_t* table, std::uint32_t rank_value) {
+        const std::uint8_t byte = table[rank_value / 2];
+        return (rank_value & 1) ? (byte >> 4) : (byte & 0xF);
+    }
+
+    static void set_entry(std::vector<std::uint8_t>& table, std::uint32_t rank_value,
+                          std::uint8_t entry) {
+        std::uint8_t& byte = table[rank_value / 2];
+        if (rank_value & 1) {
+            byte = static_cast<std::uint8_t>((byte & 0x0F) | (entry << 4));
+        } else {
+            byte = static_cast<std::uint8_t>((byte & 0xF0) | entry);
+        }
+    }
+
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    const std::uint8_t* table_ = nullptr;
+};
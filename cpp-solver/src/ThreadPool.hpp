@@ -0,0 +1,82 @@
+// src/ThreadPool.hpp
+#pragma once // Prevents the header from being included multiple times
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// --- A Minimal Fixed-Size Thread Pool ---
+// Worker threads pull tasks from a shared queue protected by a mutex.
+// This is deliberately simple: the solver submits coarse-grained tasks
+// (one whole A* solve each), so queue contention is negligible compared
+// to the work performed per task.
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the pool with the given number of worker threads.
+     * @param num_threads Number of workers; 0 means "one per hardware thread".
+     */
+    explicit ThreadPool(std::size_t num_threads = 0) {
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    // The pool owns its threads, so it must not be copied or moved.
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Enqueues a task for execution on a worker thread.
+     */
+    void submit(std::function<void()> task) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    std::size_t size() const { return workers_.size(); }
+
+private:
+    void worker_loop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
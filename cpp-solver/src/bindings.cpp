@@ -1,12 +1,311 @@
 // src/bindings.cpp
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>    // Zero-copy views over NumPy state batches
 #include <pybind11/stl.h>      // Required for automatic type conversion (vector, optional, etc.)
 #include <pybind11/operators.h> // For comparing states if needed
 
+#include "AsyncSolveExecutor.hpp"
+#include "DatabaseBuilder.hpp"
+#include "ParallelSolver.hpp"
+#include "PatternDatabase.hpp"
 #include "PuzzleSolver.hpp"
+#include "SimdHeuristic.hpp"
+#include "Metrics.hpp"
+#include "MoveEncoding.hpp"
+#include "SolutionStore.hpp"
+#include "Tablebase.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 
 namespace py = pybind11;
 
+// A single pool shared by all solve_batch calls. Constructed lazily on first
+// use so importing the module stays cheap for callers that never batch.
+static ThreadPool& shared_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// Module-wide pattern database, attached to every solver once loaded via
+// load_pattern_database(). The mmap is shared between worker processes.
+static PatternDatabase& shared_pdb() {
+    static PatternDatabase pdb;
+    return pdb;
+}
+
+// Module-wide endgame tablebase (3x3 only), loaded via load_tablebase().
+static Tablebase& shared_tb() {
+    static Tablebase tb;
+    return tb;
+}
+
+// Constructs a solver wired up with whatever heuristic is configured.
+// The pattern database only covers the 3x3 puzzle, so the 4x4 solver always
+// runs with its built-in Manhattan heuristic.
+template <int N>
+static PuzzleSolver<N> make_solver() {
+    PuzzleSolver<N> solver;
+    if constexpr (N == 3) {
+        if (shared_pdb().is_loaded()) {
+            solver.set_pattern_database(&shared_pdb());
+        }
+    }
+    return solver;
+}
+
+// Packs a 9- or 16-element Python list into the 4-bits-per-tile form used
+// by the solution store, without caring about the grid size at compile time.
+static PackedState pack_list(const std::vector<int>& state_list) {
+    if (state_list.size() != 9 && state_list.size() != 16) {
+        throw std::runtime_error("Input state must contain exactly 9 or 16 integers.");
+    }
+    PackedState packed = 0;
+    for (size_t i = 0; i < state_list.size(); ++i) {
+        packed |= static_cast<PackedState>(state_list[i]) << (4 * i);
+    }
+    return packed;
+}
+
+// Copies a validated Python list into the fixed-size board array.
+template <int N>
+static StateOf<N> to_state(const std::vector<int>& state_list) {
+    StateOf<N> state;
+    std::copy_n(state_list.begin(), N * N, state.begin());
+    return state;
+}
+
+// Runs the requested algorithm for one grid size. Shared by the 3x3 and 4x4
+// dispatch paths of the solve() binding.
+template <int N>
+static std::optional<Path> solve_one(const std::vector<int>& state_list,
+                                     const std::string& algorithm, double weight,
+                                     std::uint64_t deadline_micros) {
+    PuzzleSolver<N> solver = make_solver<N>();
+    if (algorithm == "astar") {
+        // Weighted A* (f = g + w*h): w > 1 trades path quality for speed;
+        // the returned path is at most w times the optimal length. A
+        // non-zero deadline stops the search and returns None in time.
+        solver.set_weight(weight);
+        solver.set_deadline_micros(deadline_micros);
+        return solver.solve_with_a_star(to_state<N>(state_list));
+    }
+    if (weight != 1.0 || deadline_micros != 0) {
+        throw std::runtime_error(
+            "The weight and deadline_micros parameters apply to the 'astar' algorithm only.");
+    }
+    if (algorithm == "idastar") {
+        // Bounded-memory mode: no hash maps, O(depth) working set.
+        // Preferred for deep puzzles where A*'s maps grow too large.
+        return solver.solve_with_ida_star(to_state<N>(state_list));
+    }
+    if (algorithm == "ranked") {
+        // Direct-indexed mode: flat arrays over all 9! Lehmer ranks replace
+        // the hash-based closed set. 3x3 only.
+        if constexpr (N == 3) {
+            return solver.solve_with_ranked_a_star(to_state<3>(state_list));
+        } else {
+            throw std::runtime_error("The ranked mode covers 3x3 puzzles only.");
+        }
+    }
+    if (algorithm == "tablebase") {
+        // Search-free mode: every 3x3 solve is a chain of O(1) lookups in
+        // the precomputed endgame table (see load_tablebase()).
+        if constexpr (N == 3) {
+            if (!shared_tb().is_loaded()) {
+                throw std::runtime_error(
+                    "No tablebase loaded; call load_tablebase(path) first.");
+            }
+            return shared_tb().solve(PuzzleSolver<3>::pack(to_state<3>(state_list)));
+        } else {
+            throw std::runtime_error("The tablebase covers 3x3 puzzles only.");
+        }
+    }
+    throw std::runtime_error("Unknown algorithm: '" + algorithm +
+                             "'. Expected 'astar', 'idastar', 'ranked' or 'tablebase'.");
+}
+
+// Registers a persistent solver class for one grid size. A long-lived
+// instance keeps its search structures (node arena, hash index, open heap
+// storage) between solve() calls — they are cleared but never deallocated,
+// so repeated solves skip the rehash/reallocation costs a fresh solver pays.
+template <int N>
+static void register_solver_class(py::module_& m, const char* name) {
+    py::class_<PuzzleSolver<N>>(m, name)
+        .def(py::init([] { return make_solver<N>(); }))
+        .def("solve", [](PuzzleSolver<N>& self, const std::vector<int>& state_list,
+                         const std::string& algorithm, double weight) -> std::optional<Path> {
+            if (state_list.size() != static_cast<size_t>(N * N)) {
+                throw std::runtime_error("Input state must contain exactly " +
+                                         std::to_string(N * N) + " integers.");
+            }
+            if (algorithm == "astar") {
+                self.set_weight(weight);
+                return self.solve_with_a_star(to_state<N>(state_list));
+            }
+            if (weight != 1.0) {
+                throw std::runtime_error("The weight parameter applies to the 'astar' algorithm only.");
+            }
+            if (algorithm == "idastar") {
+                return self.solve_with_ida_star(to_state<N>(state_list));
+            }
+            if (algorithm == "ranked") {
+                if constexpr (N == 3) {
+                    return self.solve_with_ranked_a_star(to_state<3>(state_list));
+                } else {
+                    throw std::runtime_error("The ranked mode covers 3x3 puzzles only.");
+                }
+            }
+            throw std::runtime_error("Unknown algorithm: '" + algorithm +
+                                     "'. Expected 'astar', 'idastar' or 'ranked'.");
+        }, py::arg("state"), py::arg("algorithm") = "astar", py::arg("weight") = 1.0)
+        .def("solve_anytime", [](PuzzleSolver<N>& self, const std::vector<int>& state_list,
+                                 std::uint64_t deadline_micros)
+                 -> std::pair<std::optional<Path>, SolveStats> {
+            if (state_list.size() != static_cast<size_t>(N * N)) {
+                throw std::runtime_error("Input state must contain exactly " +
+                                         std::to_string(N * N) + " integers.");
+            }
+            SolveStats stats;
+            auto path = self.solve_anytime(to_state<N>(state_list), deadline_micros, &stats);
+            return {std::move(path), stats};
+        }, py::arg("state"), py::arg("deadline_micros"))
+        .def("set_transposition_cache_capacity",
+             &PuzzleSolver<N>::set_transposition_cache_capacity, py::arg("capacity"),
+             "Resizes the cross-call state -> distance cache; 0 disables it")
+        .def_property_readonly("transposition_cache_size",
+                               &PuzzleSolver<N>::transposition_cache_size)
+        .def("seed_transposition_path", [](PuzzleSolver<N>& self,
+                                           const std::vector<int>& state_list,
+                                           const Path& path) {
+            if (state_list.size() != static_cast<size_t>(N * N)) {
+                throw std::runtime_error("Input state must contain exactly " +
+                                         std::to_string(N * N) + " integers.");
+            }
+            self.seed_transposition_path(to_state<N>(state_list), path);
+        }, py::arg("state"), py::arg("path"),
+           "Primes the transposition cache with a known optimal path for state")
+        .def("solve_with_stats", [](PuzzleSolver<N>& self,
+                                    const std::vector<int>& state_list)
+                 -> std::pair<std::optional<Path>, SolveStats> {
+            if (state_list.size() != static_cast<size_t>(N * N)) {
+                throw std::runtime_error("Input state must contain exactly " +
+                                         std::to_string(N * N) + " integers.");
+            }
+            SolveStats stats;
+            auto path = self.solve_with_a_star(to_state<N>(state_list), &stats);
+            return {std::move(path), stats};
+        }, py::arg("state"));
+}
+
+// Registers a background executor class for one grid size (see
+// AsyncSolveExecutor.hpp). submit() returns immediately with a SolveFuture,
+// so an asyncio server can enqueue solves without blocking its event loop;
+// duplicate in-flight states coalesce onto one search.
+template <int N>
+static void register_executor_class(py::module_& m, const char* name) {
+    py::class_<AsyncSolveExecutor<N>>(m, name)
+        .def(py::init([](std::size_t num_threads) {
+            return new AsyncSolveExecutor<N>([] { return make_solver<N>(); }, num_threads);
+        }), py::arg("num_threads") = 0)
+        .def("submit", [](AsyncSolveExecutor<N>& self, const std::vector<int>& state_list,
+                          std::uint64_t deadline_micros,
+                          const std::optional<std::vector<int>>& seed_state,
+                          const std::optional<Path>& seed_moves) {
+            if (state_list.size() != static_cast<size_t>(N * N)) {
+                throw std::runtime_error("Input state must contain exactly " +
+                                         std::to_string(N * N) + " integers.");
+            }
+            if (seed_state.has_value() != seed_moves.has_value()) {
+                throw std::runtime_error(
+                    "seed_state and seed_moves must be given together.");
+            }
+            std::optional<typename AsyncSolveExecutor<N>::Seed> seed;
+            if (seed_state) {
+                if (seed_state->size() != static_cast<size_t>(N * N)) {
+                    throw std::runtime_error("Seed state must contain exactly " +
+                                             std::to_string(N * N) + " integers.");
+                }
+                seed = {to_state<N>(*seed_state), *seed_moves};
+            }
+            return self.submit(to_state<N>(state_list), deadline_micros, std::move(seed));
+        }, py::arg("state"), py::arg("deadline_micros") = 0,
+           py::arg("seed_state") = py::none(), py::arg("seed_moves") = py::none(),
+           "Enqueues a solve and returns a SolveFuture; identical in-flight "
+           "states share one search")
+        .def_property_readonly("num_threads", &AsyncSolveExecutor<N>::num_threads);
+}
+
+// Solves a batch of validated states, fanning the work out across the
+// shared pool. Shared by the list and NumPy overloads of solve_batch.
+// Must be called with the GIL released: it blocks until all solves finish.
+static std::vector<std::optional<Path>> solve_batch_states(
+    const std::vector<std::vector<int>>& state_lists) {
+    metrics::registry().batch_size.observe(state_lists.size());
+    std::vector<std::optional<Path>> results(state_lists.size());
+
+    // Score every root with the vectorized batch heuristic and hand the
+    // hardest puzzles to the pool first: longest-job-first keeps an
+    // expensive solve from landing last and dragging out the tail while
+    // other workers sit idle. Mixed batches get one kernel call per grid
+    // size.
+    std::vector<std::int32_t> root_h(state_lists.size());
+    for (int grid : {3, 4}) {
+        std::vector<std::uint64_t> grid_states;
+        std::vector<size_t> grid_indices;
+        for (size_t i = 0; i < state_lists.size(); ++i) {
+            if (static_cast<int>(state_lists[i].size()) == grid * grid) {
+                std::uint64_t state = 0;
+                for (size_t j = 0; j < state_lists[i].size(); ++j) {
+                    state |= static_cast<std::uint64_t>(state_lists[i][j]) << (4 * j);
+                }
+                grid_states.push_back(state);
+                grid_indices.push_back(i);
+            }
+        }
+        std::vector<std::int32_t> grid_h(grid_states.size());
+        simd_heuristic::manhattan_batch(grid_states.data(), grid_h.data(),
+                                        grid_states.size(), grid);
+        for (size_t k = 0; k < grid_indices.size(); ++k) {
+            root_h[grid_indices[k]] = grid_h[k];
+        }
+    }
+    std::vector<size_t> order(state_lists.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return root_h[a] > root_h[b];
+    });
+
+    std::atomic<size_t> remaining{state_lists.size()};
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+
+    for (size_t i : order) {
+        shared_pool().submit([i, &state_lists, &results, &remaining,
+                              &done_mutex, &done_cv] {
+            if (state_lists[i].size() == 9) {
+                PuzzleSolver<3> solver = make_solver<3>();
+                results[i] = solver.solve_with_a_star(to_state<3>(state_lists[i]));
+            } else {
+                PuzzleSolver<4> solver = make_solver<4>();
+                results[i] = solver.solve_with_a_star(to_state<4>(state_lists[i]));
+            }
+            if (remaining.fetch_sub(1) == 1) {
+                std::unique_lock<std::mutex> lock(done_mutex);
+                done_cv.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_cv.wait(lock, [&] { return remaining.load() == 0; });
+    return results;
+}
+
 // This macro creates a Python module.
 // The first argument is the name of the module as it will appear in Python (e.g., `import cpp-solver`).
 // The second argument, 'm', is a variable representing the module object.
@@ -16,17 +315,456 @@ PYBIND11_MODULE(cpp_solver, m) {
     // Expose the 'solve_with_a_star' function to Python.
     // We name it "solve" in Python for convenience.
     // We use a lambda function to wrap the C++ class instantiation and method call.
-    m.def("solve", [](const std::vector<int>& state_list) -> std::optional<Path> {
-        if (state_list.size() != 9) {
-            throw std::runtime_error("Input state must contain exactly 9 integers.");
-        }
-        
-        // Convert the Python list to our C++ State (std::array)
-        State initial_state;
-        std::copy_n(state_list.begin(), 9, initial_state.begin());
-        
-        PuzzleSolver solver;
-        return solver.solve_with_a_star(initial_state);
-
-    }, "Solves a 3x3 puzzle using the A* algorithm");
+    m.def("solve", [](const std::vector<int>& state_list,
+                      const std::string& algorithm, double weight,
+                      std::uint64_t deadline_micros) -> std::optional<Path> {
+        // The grid size is inferred from the input length: 9 tiles for the
+        // 8-puzzle, 16 for the 15-puzzle.
+        if (state_list.size() == 9) {
+            return solve_one<3>(state_list, algorithm, weight, deadline_micros);
+        }
+        if (state_list.size() == 16) {
+            return solve_one<4>(state_list, algorithm, weight, deadline_micros);
+        }
+        throw std::runtime_error("Input state must contain exactly 9 or 16 integers.");
+
+    }, "Solves a 3x3 or 4x4 puzzle using the A* or IDA* algorithm",
+       py::arg("state"), py::arg("algorithm") = "astar", py::arg("weight") = 1.0,
+       py::arg("deadline_micros") = 0);
+
+    // Anytime mode: weighted A* restarts inside a wall-clock budget. Always
+    // answers by the deadline with the best incumbent found; check
+    // stats.proven_optimal / stats.suboptimality_bound for its quality.
+    m.def("solve_anytime", [](const std::vector<int>& state_list,
+                              std::uint64_t deadline_micros)
+              -> std::pair<std::optional<Path>, SolveStats> {
+        SolveStats stats;
+        std::optional<Path> path;
+        if (state_list.size() == 9) {
+            PuzzleSolver<3> solver = make_solver<3>();
+            path = solver.solve_anytime(to_state<3>(state_list), deadline_micros, &stats);
+        } else if (state_list.size() == 16) {
+            PuzzleSolver<4> solver = make_solver<4>();
+            path = solver.solve_anytime(to_state<4>(state_list), deadline_micros, &stats);
+        } else {
+            throw std::runtime_error("Input state must contain exactly 9 or 16 integers.");
+        }
+        return {std::move(path), stats};
+    }, "Returns (path, SolveStats): the best path found within the deadline",
+       py::arg("state"), py::arg("deadline_micros"));
+
+    // Solve a whole batch of puzzles in one call. The GIL is released for the
+    // duration of the search work, so other Python threads (e.g. uvicorn
+    // request handlers) keep running while the C++ thread pool fans the
+    // solves out across cores.
+    m.def("solve_batch", [](const std::vector<std::vector<int>>& state_lists)
+              -> std::vector<std::optional<Path>> {
+        // Validate while we still hold the GIL; after this point we only
+        // touch plain C++ data. (pybind11 already deep-copied the lists.)
+        for (const auto& state_list : state_lists) {
+            if (state_list.size() != 9 && state_list.size() != 16) {
+                throw std::runtime_error("Each state must contain exactly 9 or 16 integers.");
+            }
+        }
+
+        std::vector<std::optional<Path>> results;
+        {
+            py::gil_scoped_release release;
+            results = solve_batch_states(state_lists);
+        }
+        return results;
+
+    }, "Solves a batch of 3x3 and/or 4x4 puzzles in parallel, releasing the GIL");
+
+    // Zero-copy variant for NumPy callers: states come in as one uint8
+    // array of shape (batch, 9) or (batch, 16), read straight from the
+    // buffer instead of converting Python ints element by element. Results
+    // come back as a preallocated pair of arrays — moves with shape
+    // (batch, longest_path, 2) and per-puzzle path lengths (-1 marks an
+    // unsolvable state) — so build_db.py-scale workloads cross the
+    // boundary at memcpy speed in both directions.
+    m.def("solve_batch_numpy", [](
+              const py::array_t<std::uint8_t, py::array::c_style>& states) -> py::tuple {
+        const py::buffer_info buf = states.request();
+        if (buf.ndim != 2 || (buf.shape[1] != 9 && buf.shape[1] != 16)) {
+            throw std::runtime_error(
+                "Expected a C-contiguous uint8 array of shape (batch, 9) or (batch, 16).");
+        }
+        const size_t batch = static_cast<size_t>(buf.shape[0]);
+        const size_t cells = static_cast<size_t>(buf.shape[1]);
+        const std::uint8_t* data = static_cast<const std::uint8_t*>(buf.ptr);
+
+        // Raw byte reads, no per-element Python object traffic.
+        std::vector<std::vector<int>> state_lists(batch);
+        for (size_t i = 0; i < batch; ++i) {
+            state_lists[i].assign(data + i * cells, data + (i + 1) * cells);
+        }
+
+        std::vector<std::optional<Path>> results;
+        {
+            py::gil_scoped_release release;
+            results = solve_batch_states(state_lists);
+        }
+
+        size_t longest = 0;
+        for (const auto& result : results) {
+            if (result.has_value() && result->size() > longest) {
+                longest = result->size();
+            }
+        }
+        py::array_t<std::int8_t> moves(
+            {static_cast<py::ssize_t>(batch), static_cast<py::ssize_t>(longest),
+             static_cast<py::ssize_t>(2)});
+        py::array_t<std::int32_t> lengths(static_cast<py::ssize_t>(batch));
+        std::int8_t* moves_out = moves.mutable_data();
+        std::int32_t* lengths_out = lengths.mutable_data();
+        std::fill(moves_out, moves_out + batch * longest * 2, std::int8_t{0});
+        for (size_t i = 0; i < batch; ++i) {
+            if (!results[i].has_value()) {
+                lengths_out[i] = -1;
+                continue;
+            }
+            lengths_out[i] = static_cast<std::int32_t>(results[i]->size());
+            std::int8_t* row = moves_out + i * longest * 2;
+            for (size_t j = 0; j < results[i]->size(); ++j) {
+                row[2 * j] = static_cast<std::int8_t>((*results[i])[j].first);
+                row[2 * j + 1] = static_cast<std::int8_t>((*results[i])[j].second);
+            }
+        }
+        return py::make_tuple(std::move(moves), std::move(lengths));
+    }, "Batch solve over a uint8 (batch, 9|16) array; returns (moves, lengths) arrays",
+       py::arg("states"));
+
+    // Zero-copy NumPy overload of manhattan_batch, registered first so
+    // uint8 arrays bind here without conversion: states are packed straight
+    // from the buffer and scores land in a fresh int32 array.
+    m.def("manhattan_batch", [](
+              const py::array_t<std::uint8_t, py::array::c_style>& states)
+              -> py::array_t<std::int32_t> {
+        const py::buffer_info buf = states.request();
+        if (buf.ndim != 2 || (buf.shape[1] != 9 && buf.shape[1] != 16)) {
+            throw std::runtime_error(
+                "Expected a C-contiguous uint8 array of shape (batch, 9) or (batch, 16).");
+        }
+        const size_t batch = static_cast<size_t>(buf.shape[0]);
+        const size_t cells = static_cast<size_t>(buf.shape[1]);
+        const std::uint8_t* data = static_cast<const std::uint8_t*>(buf.ptr);
+
+        std::vector<std::uint64_t> packed(batch);
+        for (size_t i = 0; i < batch; ++i) {
+            std::uint64_t state = 0;
+            for (size_t j = 0; j < cells; ++j) {
+                state |= static_cast<std::uint64_t>(data[i * cells + j]) << (4 * j);
+            }
+            packed[i] = state;
+        }
+        py::array_t<std::int32_t> out(static_cast<py::ssize_t>(batch));
+        simd_heuristic::manhattan_batch(packed.data(), out.mutable_data(), batch,
+                                        cells == 9 ? 3 : 4);
+        return out;
+    }, py::arg("states"));
+
+    // Vectorized bulk heuristic evaluation. One call scores a whole list of
+    // states using the widest SIMD path the CPU supports (AVX2, SSSE3 or
+    // scalar, picked at runtime); build_db.py and other bulk tooling use it
+    // to rank states without a Python-side loop. All states must share one
+    // grid size.
+    m.def("manhattan_batch", [](const std::vector<std::vector<int>>& state_lists)
+              -> std::vector<int> {
+        if (state_lists.empty()) {
+            return {};
+        }
+        const size_t cells = state_lists.front().size();
+        if (cells != 9 && cells != 16) {
+            throw std::runtime_error("Each state must contain exactly 9 or 16 integers.");
+        }
+        std::vector<std::uint64_t> packed(state_lists.size());
+        for (size_t i = 0; i < state_lists.size(); ++i) {
+            if (state_lists[i].size() != cells) {
+                throw std::runtime_error("All states in a batch must have the same grid size.");
+            }
+            packed[i] = pack_list(state_lists[i]);
+        }
+        std::vector<std::int32_t> out(state_lists.size());
+        const int grid = (cells == 9) ? 3 : 4;
+        simd_heuristic::manhattan_batch(packed.data(), out.data(), packed.size(), grid);
+        return std::vector<int>(out.begin(), out.end());
+    }, "Computes Manhattan distances for a batch of states with SIMD",
+       py::arg("states"));
+
+    // Hash-distributed parallel A*: one solve spread across many cores.
+    // Meant for hard 4x4 instances whose node counts overwhelm a single
+    // thread; for easy puzzles the distribution overhead outweighs the
+    // parallelism. The GIL is released for the duration of the search.
+    m.def("solve_parallel", [](const std::vector<int>& state_list,
+                               int num_threads) -> std::optional<Path> {
+        if (state_list.size() == 9) {
+            StateOf<3> state = to_state<3>(state_list);
+            py::gil_scoped_release release;
+            return ParallelPuzzleSolver<3>(num_threads).solve(state);
+        }
+        if (state_list.size() == 16) {
+            StateOf<4> state = to_state<4>(state_list);
+            py::gil_scoped_release release;
+            return ParallelPuzzleSolver<4>(num_threads).solve(state);
+        }
+        throw std::runtime_error("Input state must contain exactly 9 or 16 integers.");
+    }, "Solves a puzzle with hash-distributed parallel A*",
+       py::arg("state"), py::arg("num_threads") = 0);
+
+    // Long-lived solver objects with reusable internal search buffers.
+    // Hold one per worker process and call solve() on it repeatedly.
+    register_solver_class<3>(m, "Solver3x3");
+    register_solver_class<4>(m, "Solver4x4");
+
+    // Result handle for the background executors below. result() releases
+    // the GIL while it waits, so Python threads keep running; callbacks
+    // registered with add_done_callback fire on the worker thread that
+    // finished the solve (pair them with loop.call_soon_threadsafe to
+    // resolve an asyncio future — see PuzzleService.solve_using_database_async).
+    py::class_<SolveFuture>(m, "SolveFuture")
+        .def("done", &SolveFuture::done,
+             "True once the solve has finished (with or without a path)")
+        .def("result", [](const SolveFuture& self) {
+            std::optional<Path> result;
+            {
+                py::gil_scoped_release release;
+                result = self.result();
+            }
+            return result;
+        }, "Blocks until the solve finishes; returns the path or None")
+        .def("add_done_callback", [](SolveFuture& self, py::function fn) {
+            // The wrapper owns the only strong reference to the Python
+            // callable; it is released under the GIL inside the callback so
+            // the std::function's later destruction (on a worker thread,
+            // GIL not held) has nothing left to decref.
+            auto fn_holder = std::make_shared<py::function>(std::move(fn));
+            self.on_complete([fn_holder](const std::optional<Path>& result) {
+                py::gil_scoped_acquire gil;
+                (*fn_holder)(result);
+                *fn_holder = py::function();
+            });
+        }, py::arg("fn"),
+           "Calls fn(path_or_None) when the solve finishes; immediately if it already has");
+
+    // Background solve executors: worker threads pulling from a shared
+    // queue, one long-lived solver per worker, duplicate in-flight states
+    // coalesced onto a single search. Hold one per worker process.
+    register_executor_class<3>(m, "Executor3x3");
+    register_executor_class<4>(m, "Executor4x4");
+
+    // Per-solve instrumentation counters (see SolveStats in PuzzleSolver.hpp).
+    py::class_<SolveStats>(m, "SolveStats")
+        .def_readonly("nodes_expanded", &SolveStats::nodes_expanded)
+        .def_readonly("nodes_generated", &SolveStats::nodes_generated)
+        .def_readonly("duplicate_hits", &SolveStats::duplicate_hits)
+        .def_readonly("peak_open_size", &SolveStats::peak_open_size)
+        .def_readonly("total_nodes", &SolveStats::total_nodes)
+        .def_readonly("root_heuristic", &SolveStats::root_heuristic)
+        .def_readonly("wall_micros", &SolveStats::wall_micros)
+        .def_readonly("suboptimality_bound", &SolveStats::suboptimality_bound)
+        .def_readonly("deadline_expired", &SolveStats::deadline_expired)
+        .def_readonly("proven_optimal", &SolveStats::proven_optimal);
+
+    // Like solve() with algorithm="astar", but also returns the search
+    // counters so callers can monitor solver behaviour per request.
+    m.def("solve_with_stats", [](const std::vector<int>& state_list)
+              -> std::pair<std::optional<Path>, SolveStats> {
+        SolveStats stats;
+        std::optional<Path> path;
+        if (state_list.size() == 9) {
+            PuzzleSolver<3> solver = make_solver<3>();
+            path = solver.solve_with_a_star(to_state<3>(state_list), &stats);
+        } else if (state_list.size() == 16) {
+            PuzzleSolver<4> solver = make_solver<4>();
+            path = solver.solve_with_a_star(to_state<4>(state_list), &stats);
+        } else {
+            throw std::runtime_error("Input state must contain exactly 9 or 16 integers.");
+        }
+        return {std::move(path), stats};
+    }, "Solves a puzzle with A* and returns (path, SolveStats)",
+       py::arg("state"));
+
+    // Snapshot of the process-wide hot-path metrics (see Metrics.hpp).
+    // Counters come back as integers; histograms as dicts with "count",
+    // "sum" and "buckets" — a list of (upper_bound, count) pairs whose
+    // last bound is 2^64-1 and stands for +inf. main.py renders these in
+    // the Prometheus text format.
+    m.def("get_metrics", [] {
+        const auto hist_dict = [](const metrics::Histogram& hist) {
+            const metrics::Histogram::Snapshot snap = hist.snapshot();
+            py::dict d;
+            d["count"] = snap.count;
+            d["sum"] = snap.sum;
+            d["buckets"] = snap.buckets;
+            return d;
+        };
+        metrics::Registry& reg = metrics::registry();
+        py::dict d;
+        d["solves_total"] = reg.solves_total.value();
+        d["solves_unsolvable_total"] = reg.solves_unsolvable_total.value();
+        d["nodes_expanded_total"] = reg.nodes_expanded_total.value();
+        d["nodes_generated_total"] = reg.nodes_generated_total.value();
+        d["transposition_cache_hits_total"] = reg.transposition_cache_hits_total.value();
+        d["transposition_cache_misses_total"] = reg.transposition_cache_misses_total.value();
+        d["tablebase_solves_total"] = reg.tablebase_solves_total.value();
+        d["tablebase_unsolvable_total"] = reg.tablebase_unsolvable_total.value();
+        d["async_solves_coalesced_total"] = reg.async_solves_coalesced_total.value();
+        d["solve_latency_micros"] = hist_dict(reg.solve_latency_micros);
+        d["batch_size"] = hist_dict(reg.batch_size);
+        return d;
+    }, "Snapshot of the process-wide solver metrics");
+
+    // O(n) permutation-parity solvability test: lets callers reject
+    // unsolvable inputs up front instead of paying for a search that
+    // exhausts the reachable space before failing.
+    m.def("is_solvable", [](const std::vector<int>& state_list) {
+        if (state_list.size() != 9 && state_list.size() != 16) {
+            throw std::runtime_error("Input state must contain exactly 9 or 16 integers.");
+        }
+        std::vector<bool> seen(state_list.size(), false);
+        for (int tile : state_list) {
+            if (tile < 0 || tile >= static_cast<int>(state_list.size()) || seen[tile]) {
+                throw std::runtime_error(
+                    "Input state must be a permutation of 0.." +
+                    std::to_string(state_list.size() - 1) + ".");
+            }
+            seen[tile] = true;
+        }
+        return state_list.size() == 9
+                   ? PuzzleSolver<3>::is_solvable(to_state<3>(state_list))
+                   : PuzzleSolver<4>::is_solvable(to_state<4>(state_list));
+    }, "Whether the state can reach the goal (permutation-parity check)",
+       py::arg("state"));
+
+    // The native, mmap-backed solution database. Replaces the pickled
+    // dictionaries + FAISS index: workers attach in O(1) and share one
+    // page-cached copy of the file instead of private deserialized dicts.
+    py::class_<SolutionStore>(m, "SolutionStore")
+        .def(py::init<>())
+        .def("load", &SolutionStore::load, py::arg("path"),
+             "Memory-maps a solution store file")
+        .def("lookup", [](const SolutionStore& store,
+                          const std::vector<int>& state_list) -> std::optional<Path> {
+            return store.lookup(pack_list(state_list));
+        }, py::arg("state"), "Exact-match lookup; returns the move path or None")
+        .def("lookup_compact", [](const SolutionStore& store,
+                                  const std::vector<int>& state_list)
+                 -> std::optional<std::pair<py::bytes, std::uint32_t>> {
+            // The encoded form as stored: 2 bits per move, four per byte.
+            // Decode with decode_moves(state, data, num_moves).
+            auto hit = store.lookup_compact(pack_list(state_list));
+            if (!hit) {
+                return std::nullopt;
+            }
+            return std::make_pair(
+                py::bytes(reinterpret_cast<const char*>(hit->first.data()),
+                          hit->first.size()),
+                hit->second);
+        }, py::arg("state"),
+           "Exact-match lookup returning (encoded_bytes, num_moves) or None")
+        .def("contains", [](const SolutionStore& store,
+                            const std::vector<int>& state_list) {
+            return store.contains(pack_list(state_list));
+        }, py::arg("state"))
+        .def("nearest", [](const SolutionStore& store, const std::vector<int>& state_list,
+                           int k) -> std::vector<std::pair<std::vector<int>, int>> {
+            // The SIMD replacement for the FAISS flat-L2 search: a linear
+            // Hamming scan of the packed index, returning the k most
+            // similar stored states (each decoded back to a flat list)
+            // with their distances in misplaced cells, ascending.
+            auto hits = store.top_k_nearest(pack_list(state_list), k);
+            const int cells = store.grid_size() * store.grid_size();
+            std::vector<std::pair<std::vector<int>, int>> result;
+            result.reserve(hits.size());
+            for (const auto& [state, distance] : hits) {
+                std::vector<int> tiles(cells);
+                for (int i = 0; i < cells; ++i) {
+                    tiles[i] = static_cast<int>((state >> (4 * i)) & 0xF);
+                }
+                result.push_back({std::move(tiles), distance});
+            }
+            return result;
+        }, py::arg("state"), py::arg("k") = 1,
+           "Top-k most similar stored states as (state, hamming_distance) pairs")
+        .def("__len__", [](const SolutionStore& store) { return store.size(); })
+        .def_property_readonly("grid_size", &SolutionStore::grid_size);
+
+    // The whole database build pipeline in one native call: a multi-threaded
+    // BFS outward from the goal enumerates the closest num_states states,
+    // knows each one's optimal move at discovery time, and serializes the
+    // chained paths into a solution store file — no per-state solving.
+    // build_db.py is just a driver around this.
+    m.def("build_solution_store", [](const std::string& path, int grid_size,
+                                     std::size_t num_states, int num_threads) {
+        if (grid_size != 3 && grid_size != 4) {
+            throw std::runtime_error("grid_size must be 3 or 4.");
+        }
+        py::gil_scoped_release release;
+        if (grid_size == 3) {
+            database_builder::build_solution_store<3>(path, num_states, num_threads);
+        } else {
+            database_builder::build_solution_store<4>(path, num_states, num_threads);
+        }
+    }, "Builds a solution store for the num_states states closest to the goal",
+       py::arg("path"), py::arg("grid_size"), py::arg("num_states"),
+       py::arg("num_threads") = 0);
+
+    // Writes a solution store file from parallel lists of states and their
+    // move paths. Used by build_db.py to produce the database artifact.
+    m.def("write_solution_store", [](const std::string& path, int grid_size,
+                                     const std::vector<std::vector<int>>& states,
+                                     const std::vector<Path>& paths) {
+        if (states.size() != paths.size()) {
+            throw std::runtime_error("states and paths must have the same length.");
+        }
+        std::vector<std::pair<PackedState, Path>> entries;
+        entries.reserve(states.size());
+        for (size_t i = 0; i < states.size(); ++i) {
+            entries.emplace_back(pack_list(states[i]), paths[i]);
+        }
+        SolutionStore::write_file(path, grid_size, std::move(entries));
+    }, "Writes a solution store file from states and their move paths",
+       py::arg("path"), py::arg("grid_size"), py::arg("states"), py::arg("paths"));
+
+    // The compact path codec used by the solution store's on-disk format:
+    // 2 bits per move (four per byte), replayed from the starting state.
+    // Exposed so callers can store or transmit paths in encoded form and
+    // expand them only when needed.
+    m.def("encode_moves", [](const std::vector<int>& state_list, const Path& path) {
+        const int grid = state_list.size() == 9 ? 3 : 4;
+        const std::vector<std::uint8_t> encoded =
+            move_encoding::encode(pack_list(state_list), path, grid);
+        return py::bytes(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    }, "Encodes a move path as packed 2-bit directions",
+       py::arg("state"), py::arg("path"));
+
+    m.def("decode_moves", [](const std::vector<int>& state_list, const py::bytes& data,
+                             std::uint32_t num_moves) -> Path {
+        const int grid = state_list.size() == 9 ? 3 : 4;
+        const std::string raw = data;
+        if (raw.size() < move_encoding::encoded_size(num_moves)) {
+            throw std::runtime_error("Encoded data is too short for num_moves moves.");
+        }
+        return move_encoding::decode(pack_list(state_list),
+                                     reinterpret_cast<const std::uint8_t*>(raw.data()),
+                                     num_moves, grid);
+    }, "Decodes packed 2-bit directions back into (row, col) moves",
+       py::arg("state"), py::arg("data"), py::arg("num_moves"));
+
+    // Memory-map an endgame tablebase file (built by the tablebase_builder
+    // tool). Once loaded, solve(state, algorithm="tablebase") answers any
+    // 3x3 puzzle without searching.
+    m.def("load_tablebase", [](const std::string& path) {
+        shared_tb().load(path);
+    }, "Loads the precomputed 8-puzzle endgame tablebase from a file",
+       py::arg("path"));
+
+    // Memory-map a pattern database file (built by the pdb_builder tool).
+    // Call once at worker startup; all subsequent solves use the precomputed
+    // heuristic, and workers mapping the same file share one physical copy.
+    m.def("load_pattern_database", [](const std::string& path) {
+        shared_pdb().load(path);
+    }, "Loads a precomputed pattern database heuristic from a file",
+       py::arg("path"));
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 // src/main.cpp
 #include "PuzzleSolver.hpp"
-#include <string> // For std::stoi
+#include <cstdio>  // For the buffered binary streaming I/O
+#include <string>  // For std::stoi
+#include <vector>
 
 // Helper function to print a path (no change)
 void print_path(const Path& path) {
@@ -15,10 +17,168 @@ void print_path(const Path& path) {
     std::cout << "]" << std::endl;
 }
 
+// --- Streaming Batch Mode ---
+// Reading many puzzles from stdin with one long-lived solver amortizes both
+// process startup and solver warm-up over the whole batch; offline replays
+// were paying more fork/exec overhead than solve time with the
+// one-puzzle-per-process interface.
+
+// Solves one state of either grid size with the appropriate reused solver.
+static std::optional<Path> solve_streamed(const std::vector<int>& tiles,
+                                          PuzzleSolver<3>& solver3,
+                                          PuzzleSolver<4>& solver4) {
+    if (tiles.size() == 9) {
+        StateOf<3> state;
+        std::copy(tiles.begin(), tiles.end(), state.begin());
+        return solver3.solve_with_a_star(state);
+    }
+    StateOf<4> state;
+    std::copy(tiles.begin(), tiles.end(), state.begin());
+    return solver4.solve_with_a_star(state);
+}
+
+// JSONL framing: one JSON array of 9 or 16 tile numbers per input line
+// (e.g. "[1,2,3,4,5,6,0,7,8]"); one JSON result object per output line,
+// {"solution": [[r,c],...]} or {"solution": null}.
+static int run_stream_jsonl() {
+    // Untie the standard streams: the replay pipeline wants throughput,
+    // not prompt-by-prompt interleaving.
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    PuzzleSolver<3> solver3;
+    PuzzleSolver<4> solver4;
+    std::string line;
+    std::string out;
+    while (std::getline(std::cin, line)) {
+        // Minimal JSON array scan: collect the integers between brackets.
+        // Tiles are small non-negative integers, so a sign or decimal
+        // point anywhere makes the line malformed — skipping it beats
+        // silently parsing "-1" as 1 and solving the wrong puzzle.
+        std::vector<int> tiles;
+        int value = 0;
+        bool in_number = false;
+        bool malformed = false;
+        for (char c : line) {
+            if (c >= '0' && c <= '9') {
+                value = value * 10 + (c - '0');
+                in_number = true;
+                continue;
+            }
+            if (c == '-' || c == '.') {
+                malformed = true;
+            }
+            if (in_number) {
+                tiles.push_back(value);
+                value = 0;
+                in_number = false;
+            }
+        }
+        if (in_number) {
+            tiles.push_back(value);
+        }
+        if (tiles.size() != 9 && tiles.size() != 16) {
+            malformed = true;
+        } else {
+            for (int tile : tiles) {
+                // Range check before the tiles reach the 4-bit packing.
+                if (tile >= static_cast<int>(tiles.size())) {
+                    malformed = true;
+                }
+            }
+        }
+        if (malformed) {
+            std::cerr << "Skipping malformed line (expected a JSON array of 9 or 16 "
+                      << "tiles in range): " << line << std::endl;
+            continue;
+        }
+
+        std::optional<Path> solution = solve_streamed(tiles, solver3, solver4);
+        out.clear();
+        if (solution.has_value()) {
+            out += "{\"solution\": [";
+            for (size_t i = 0; i < solution->size(); ++i) {
+                if (i > 0) out += ", ";
+                out += "[" + std::to_string((*solution)[i].first) + ", " +
+                       std::to_string((*solution)[i].second) + "]";
+            }
+            out += "]}";
+        } else {
+            out += "{\"solution\": null}";
+        }
+        std::cout << out << "\n"; // "\n", not std::endl: keep output buffered
+    }
+    std::cout.flush();
+    return 0;
+}
+
+// Binary framing, for pipelines that want to skip text parsing entirely.
+// Input record:  1 byte tile count (9 or 16), then that many tile bytes.
+// Output record: 1 byte found flag, then (if found) a 2-byte little-endian
+//                move count followed by 2 bytes (row, col) per move.
+static int run_stream_binary() {
+    PuzzleSolver<3> solver3;
+    PuzzleSolver<4> solver4;
+
+    int count_byte;
+    while ((count_byte = std::fgetc(stdin)) != EOF) {
+        const size_t count = static_cast<size_t>(count_byte);
+        if (count != 9 && count != 16) {
+            std::cerr << "Invalid tile count in binary stream: " << count << std::endl;
+            return 1;
+        }
+        unsigned char tile_bytes[16];
+        if (std::fread(tile_bytes, 1, count, stdin) != count) {
+            std::cerr << "Truncated state record in binary stream." << std::endl;
+            return 1;
+        }
+        std::vector<int> tiles(tile_bytes, tile_bytes + count);
+        for (int tile : tiles) {
+            // Range check before the tiles reach the 4-bit packing.
+            if (tile >= static_cast<int>(count)) {
+                std::cerr << "Tile value out of range in binary stream: " << tile
+                          << std::endl;
+                return 1;
+            }
+        }
+
+        std::optional<Path> solution = solve_streamed(tiles, solver3, solver4);
+        if (solution.has_value()) {
+            std::fputc(1, stdout);
+            const unsigned moves = static_cast<unsigned>(solution->size());
+            std::fputc(static_cast<int>(moves & 0xFF), stdout);
+            std::fputc(static_cast<int>((moves >> 8) & 0xFF), stdout);
+            for (const Move& move : *solution) {
+                std::fputc(move.first, stdout);
+                std::fputc(move.second, stdout);
+            }
+        } else {
+            std::fputc(0, stdout);
+        }
+    }
+    std::fflush(stdout);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    // Streaming batch mode: solve puzzles from stdin until EOF.
+    if (argc >= 2 && std::string(argv[1]) == "--stream") {
+        const std::string format = (argc >= 3) ? argv[2] : "jsonl";
+        if (format == "jsonl") {
+            return run_stream_jsonl();
+        }
+        if (format == "binary") {
+            return run_stream_binary();
+        }
+        std::cerr << "Unknown stream format: '" << format
+                  << "'. Expected 'jsonl' or 'binary'." << std::endl;
+        return 1;
+    }
+
     // Check if the user provided the correct number of arguments
     if (argc != 10) {
         std::cerr << "Usage: " << argv[0] << " <t1> <t2> ... <t9>" << std::endl;
+        std::cerr << "   or: " << argv[0] << " --stream [jsonl|binary]   (read states from stdin)" << std::endl;
         std::cerr << "Provide the 9 tile numbers (use 0 for empty space)." << std::endl;
         std::cerr << "Example: " << argv[0] << " 1 2 3 4 5 6 0 7 8" << std::endl;
         return 1; // Return an error code
@@ -34,8 +194,8 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: Invalid number provided. Please provide only integers." << std::endl;
         return 1;
     }
-    
-    PuzzleSolver solver;
+
+    PuzzleSolver<3> solver;
     std::cout << "Solving puzzle..." << std::endl;
     std::optional<Path> solution = solver.solve_with_a_star(initial_state);
 
@@ -47,4 +207,4 @@ int main(int argc, char* argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}
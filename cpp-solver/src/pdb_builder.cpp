@@ -0,0 +1,31 @@
+// src/pdb_builder.cpp
+//
+// Offline builder for the additive pattern database heuristic.
+// Run once (e.g. as a deployment step) to produce the table file, then point
+// the solver at it; every worker process mmaps the same file read-only, so
+// all of them share one physical copy of the tables.
+#include "PatternDatabase.hpp"
+
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    std::string output_path = "puzzle_pdb.bin";
+    if (argc == 2) {
+        output_path = argv[1];
+    } else if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [output_file]" << std::endl;
+        std::cerr << "Builds the 4-4 additive pattern database (default: puzzle_pdb.bin)." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Building 4-4 additive pattern database..." << std::endl;
+    try {
+        PatternDatabase::write_file(output_path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote pattern database to '" << output_path << "'." << std::endl;
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 # main.py
 from fastapi import FastAPI, HTTPException, Security
+from fastapi.responses import PlainTextResponse
 from pydantic import BaseModel
 from typing import List
 from fastapi.middleware.cors import CORSMiddleware
@@ -82,6 +83,36 @@ def read_root():
     }
 
 
+@app.get("/metrics", summary="Prometheus Metrics", response_class=PlainTextResponse)
+def get_metrics():
+    """
+    Exposes the native solver's hot-path metrics (latency histogram, node
+    throughput, cache hit rates) in the Prometheus text format. The
+    counters are maintained inside the C++ module with relaxed atomics, so
+    scraping here adds no per-request timing overhead in Python.
+    """
+    snapshot = puzzle_service.get_metrics()
+    if snapshot is None:
+        return "# native solver unavailable; no metrics\n"
+    prefix = "puzzle_solver_"
+    inf_bound = (1 << 64) - 1  # The last histogram bucket stands for +Inf
+    lines = []
+    for name, value in snapshot.items():
+        if isinstance(value, dict):
+            lines.append(f"# TYPE {prefix}{name} histogram")
+            cumulative = 0
+            for bound, count in value["buckets"]:
+                cumulative += count
+                le = "+Inf" if bound == inf_bound else str(bound)
+                lines.append(f'{prefix}{name}_bucket{{le="{le}"}} {cumulative}')
+            lines.append(f"{prefix}{name}_sum {value['sum']}")
+            lines.append(f"{prefix}{name}_count {value['count']}")
+        else:
+            lines.append(f"# TYPE {prefix}{name} counter")
+            lines.append(f"{prefix}{name} {value}")
+    return "\n".join(lines) + "\n"
+
+
 @app.post("/solve", response_model=SolutionPath, summary="Solve a Puzzle")
 async def solve_puzzle(puzzle: PuzzleState):
     """
@@ -91,11 +122,23 @@ async def solve_puzzle(puzzle: PuzzleState):
     """
     if len(puzzle.state) != 9:
         raise HTTPException(status_code=400, detail="Invalid puzzle state. Must contain 9 integers.")
-    
+    if sorted(puzzle.state) != list(range(9)):
+        raise HTTPException(status_code=400, detail="Invalid puzzle state. Must be a permutation of 0-8.")
+
     # Convert list to tuple for the service layer
     query_state_tuple = tuple(puzzle.state)
-    
-    solution_path = puzzle_service.solve_using_database(query_state_tuple)
+
+    # Reject unsolvable permutations up front: the parity check answers in
+    # microseconds, where a search would exhaust the reachable space first.
+    if not puzzle_service.is_solvable(query_state_tuple):
+        raise HTTPException(status_code=400, detail="The puzzle state is unsolvable (wrong permutation parity).")
+
+    # The deadline caps solve time per request (tail-latency control); with
+    # a deadline set, hard states get the best path found within the budget.
+    # The async path keeps the event loop free while C++ worker threads
+    # search, and concurrent requests for the same state share one solve.
+    solution_path = await puzzle_service.solve_using_database_async(
+        query_state_tuple, deadline_micros=config.SOLVE_DEADLINE_MICROS)
     
     if not solution_path:
         raise HTTPException(status_code=404, detail="No solution could be found for the given puzzle state.")
@@ -1,8 +1,9 @@
 # puzzle_service.py
-import faiss
+import asyncio
 import numpy as np
 import pickle
 import heapq
+import time
 from collections import deque
 from typing import List, Tuple, Dict, Optional
 import os
@@ -10,6 +11,22 @@ from tqdm import tqdm
 
 import config
 
+try:
+    import cpp_solver
+    CPP_SOLVER_AVAILABLE = True
+except ImportError:
+    CPP_SOLVER_AVAILABLE = False
+
+# FAISS is optional now that the native solution store does similar-state
+# search itself (a SIMD Hamming scan over the packed index). It is only
+# imported to read legacy .faiss/.pkl database artifacts.
+try:
+    import faiss
+    FAISS_AVAILABLE = True
+except ImportError:
+    faiss = None
+    FAISS_AVAILABLE = False
+
 DB_FILENAME_BASE = "puzzle_solutions"
 
 class PuzzleService:
@@ -18,11 +35,32 @@ class PuzzleService:
         self.vector_dim = self.grid_size ** 2
         self.goal_state = tuple(range(1, self.vector_dim)) + (0,)
         
-        self.index: Optional[faiss.Index] = None
+        self.index = None  # Legacy FAISS index; unused when the native store loads
         self.state_to_id: Dict[Tuple[int, ...], int] = {}
         self.id_to_state: Dict[int, Tuple[int, ...]] = {}
         self.solutions: Dict[Tuple[int, ...], List[Tuple[int, ...]]] = {}
-        
+
+        # The native, mmap-backed solution store produced by build_db.py.
+        # Preferred over the pickled FAISS database when present: workers
+        # attach in O(1) and share one page-cached copy of the file.
+        self.solution_store = None
+
+        # One long-lived C++ solver per worker. Its internal search buffers
+        # (node arena, hash index, heap storage) are cleared but not freed
+        # between calls, so repeated solves skip cold-start allocation costs.
+        self.cpp_solver = None
+        if CPP_SOLVER_AVAILABLE:
+            if grid_size == 3:
+                self.cpp_solver = cpp_solver.Solver3x3()
+            elif grid_size == 4:
+                self.cpp_solver = cpp_solver.Solver4x4()
+
+        # Background executor for the async path: searches run on its C++
+        # worker threads off the GIL, and identical states submitted
+        # concurrently coalesce into one solve. Created lazily so scripts
+        # that only use the synchronous API never start the threads.
+        self.cpp_executor = None
+
         # S3 client initialization is completely removed.
 
     def load_database(self):
@@ -30,6 +68,23 @@ class PuzzleService:
         Loads the FAISS index and metadata from the local filesystem.
         If the files are not found, it prints a helpful message to the console.
         """
+        # Prefer the native solution store (built by build_db.py) when the
+        # C++ module is importable; the pickle/FAISS pair below remains as
+        # the fallback for older database artifacts.
+        store_file = f"{DB_FILENAME_BASE}.store"
+        if CPP_SOLVER_AVAILABLE and os.path.exists(store_file):
+            try:
+                store = cpp_solver.SolutionStore()
+                store.load(store_file)
+                if store.grid_size == self.grid_size:
+                    self.solution_store = store
+                    print(f"Loaded native solution store '{store_file}' with {len(store)} states.")
+                    return
+                print(f"Ignoring '{store_file}': it is for grid size {store.grid_size}, "
+                      f"not {self.grid_size}.")
+            except RuntimeError as e:
+                print(f"Could not load native store '{store_file}': {e}")
+
         faiss_file = f"{DB_FILENAME_BASE}.faiss"
         meta_file = f"{DB_FILENAME_BASE}_metadata.pkl"
 
@@ -42,6 +97,12 @@ class PuzzleService:
             print("---\n")
             return # Exit the function
 
+        if not FAISS_AVAILABLE:
+            print(f"Legacy database files '{faiss_file}'/'{meta_file}' found, but the "
+                  "faiss package is not installed. Rebuild the native store with "
+                  "'python build_db.py' to use them without FAISS.")
+            return
+
         print(f"Loading database from local files: '{faiss_file}' and '{meta_file}'...")
         try:
             # Load the FAISS index from the local file
@@ -98,6 +159,48 @@ class PuzzleService:
         vector = np.array(state, dtype=np.float32) / max_val
         return vector.reshape(1, -1)
 
+    def get_metrics(self):
+        """
+        Snapshot of the native solver's process-wide metrics (counters and
+        histograms, see cpp_solver.get_metrics), or None when the C++
+        module is unavailable. All timing happens on the native hot path,
+        so reading this adds no per-request overhead.
+        """
+        if not CPP_SOLVER_AVAILABLE:
+            return None
+        return cpp_solver.get_metrics()
+
+    def is_solvable(self, state: Tuple[int, ...]) -> bool:
+        """
+        O(n) permutation-parity solvability test. Unsolvable inputs used to
+        cost a full-space search before failing; this answers in
+        microseconds. Returns False for non-permutation inputs too, so
+        callers can reject malformed states with the same check.
+        """
+        if sorted(state) != list(range(self.vector_dim)):
+            return False
+        if CPP_SOLVER_AVAILABLE:
+            return cpp_solver.is_solvable(list(state))
+        # Python fallback, same invariant as the C++ check: each slide
+        # flips both the permutation's parity and the parity of the blank's
+        # taxicab distance to its goal corner, so the two match exactly on
+        # solvable states. Cycle decomposition gives the parity in O(n).
+        parity = 0
+        visited = [False] * self.vector_dim
+        for i in range(self.vector_dim):
+            if visited[i]:
+                continue
+            length = 0
+            j = i
+            while not visited[j]:
+                visited[j] = True
+                j = self.vector_dim - 1 if state[j] == 0 else state[j] - 1
+                length += 1
+            parity ^= (length - 1) & 1
+        blank_r, blank_c = divmod(state.index(0), self.grid_size)
+        blank_distance = (self.grid_size - 1 - blank_r) + (self.grid_size - 1 - blank_c)
+        return parity == blank_distance % 2
+
     def heuristic(self, state: Tuple[int, ...]) -> int:
         distance = 0
         for i, num in enumerate(state):
@@ -116,20 +219,34 @@ class PuzzleService:
             current_state = parent_state
         return path[::-1]
 
-    def solve_with_a_star(self, initial_state: Tuple[int, ...]) -> Optional[List[Tuple[int, int]]]:
-        if CPP_SOLVER_AVAILABLE:
+    def solve_with_a_star(self, initial_state: Tuple[int, ...], weight: float = 1.0,
+                          deadline_micros: int = 0) -> Optional[List[Tuple[int, int]]]:
+        # weight > 1.0 selects weighted A* (f = g + weight * h): faster on
+        # deep puzzles, with paths at most `weight` times the optimal length.
+        # deadline_micros > 0 bounds the solve's wall-clock time; the C++
+        # anytime mode then returns the best incumbent found in the budget.
+        if self.cpp_solver is not None:
+            if deadline_micros > 0:
+                path, stats = self.cpp_solver.solve_anytime(list(initial_state), deadline_micros)
+                if path is not None and not stats.proven_optimal:
+                    print(f"Deadline-bounded solve: returning a path within "
+                          f"{stats.suboptimality_bound:g}x of optimal.")
+                return path
             # pybind11 automatically converts the C++ std::optional<Path>
             # to either a Python list of tuples or None. It's seamless.
-            return cpp_solver.solve(list(initial_state))
+            return self.cpp_solver.solve(list(initial_state), "astar", weight)
         else:
-            if initial_state == self.goal_state: 
+            if initial_state == self.goal_state:
                 return []
-            open_heap = [(self.heuristic(initial_state), initial_state)]
+            deadline = time.monotonic() + deadline_micros / 1e6 if deadline_micros > 0 else None
+            open_heap = [(weight * self.heuristic(initial_state), initial_state)]
             open_set_hash = {initial_state}
             came_from = {initial_state: None}
             g_score = {initial_state: 0}
             
             while open_heap:
+                if deadline is not None and time.monotonic() >= deadline:
+                    return None  # Deadline fired; the Python path has no incumbent to fall back on
                 current_state = heapq.heappop(open_heap)[1]
                 open_set_hash.remove(current_state)
                 if current_state == self.goal_state: return self.reconstruct_move_path(came_from, current_state)
@@ -146,15 +263,21 @@ class PuzzleService:
                     if tentative_g_score < g_score.get(neighbor_state, float('inf')):
                         came_from[neighbor_state] = (current_state, (tile_r, tile_c))
                         g_score[neighbor_state] = tentative_g_score
-                        f_score = tentative_g_score + self.heuristic(neighbor_state)
+                        f_score = tentative_g_score + weight * self.heuristic(neighbor_state)
                         if neighbor_state not in open_set_hash:
                             heapq.heappush(open_heap, (f_score, neighbor_state))
                             open_set_hash.add(neighbor_state)
             return None
 
-    def solve_single_puzzle(self, initial_state: Tuple[int, ...]) -> List[Tuple[int, ...]]:
-        path_of_moves = self.solve_with_a_star(initial_state)
+    def solve_single_puzzle(self, initial_state: Tuple[int, ...],
+                            deadline_micros: int = 0) -> List[Tuple[int, ...]]:
+        path_of_moves = self.solve_with_a_star(initial_state, deadline_micros=deadline_micros)
         if path_of_moves is None: return []
+        return self.replay_moves(initial_state, path_of_moves)
+
+    def replay_moves(self, initial_state: Tuple[int, ...],
+                     path_of_moves: List[Tuple[int, int]]) -> List[Tuple[int, ...]]:
+        """Expands a path of moves into the list of board states it visits."""
         if not path_of_moves: return [initial_state]
         path_of_states = [initial_state]
         current_state_list = list(initial_state)
@@ -209,20 +332,59 @@ class PuzzleService:
         print(f"Successfully solved and stored {solutions_found} puzzles")
 
     def add_solution_to_database(self, state, solution_path):
-        if self.index is None: self.initialize_faiss_index()
-        vector = self.state_to_vector(state)
-        faiss_id = self.index.ntotal
-        self.index.add(vector)
-        self.state_to_id[state] = faiss_id
-        self.id_to_state[faiss_id] = state
+        # The exact-match dictionary works without FAISS; the legacy vector
+        # index is only maintained when the package happens to be installed.
+        if FAISS_AVAILABLE:
+            if self.index is None: self.initialize_faiss_index()
+            vector = self.state_to_vector(state)
+            faiss_id = self.index.ntotal
+            self.index.add(vector)
+            self.state_to_id[state] = faiss_id
+            self.id_to_state[faiss_id] = state
         self.solutions[state] = solution_path
 
-    def solve_using_database(self, query_state: Tuple[int, ...]) -> List[Tuple[int, ...]]:
+    def _nearest_seed(self, query_state: Tuple[int, ...]):
+        """
+        The stored solution closest to the query, as a (state, moves) pair
+        for priming a transposition cache, or None. nearest() is a SIMD
+        Hamming scan of the native store's packed states, so finding the
+        neighbor costs about a millisecond per million entries.
+        """
+        neighbors = self.solution_store.nearest(list(query_state), 1)
+        if not neighbors:
+            return None
+        neighbor_state, distance = neighbors[0]
+        neighbor_moves = self.solution_store.lookup(neighbor_state)
+        if not neighbor_moves:
+            return None
+        print(f"Seeding search from a stored state {distance} cells away.")
+        return neighbor_state, neighbor_moves
+
+    def seed_from_nearest_solution(self, query_state: Tuple[int, ...]):
+        """
+        Primes the C++ solver's transposition cache with the stored solution
+        closest to the query; the following solve then finishes the moment
+        it reaches any state on that optimal path.
+        """
+        if self.cpp_solver is None:
+            return
+        seed = self._nearest_seed(query_state)
+        if seed:
+            self.cpp_solver.seed_transposition_path(seed[0], seed[1])
+
+    def solve_using_database(self, query_state: Tuple[int, ...],
+                             deadline_micros: int = 0) -> List[Tuple[int, ...]]:
+        if self.solution_store is not None:
+            moves = self.solution_store.lookup(list(query_state))
+            if moves is not None:
+                print("Found exact solution in native store.")
+                return self.replay_moves(query_state, moves)
+            self.seed_from_nearest_solution(query_state)
         if query_state in self.solutions:
             print("Found exact solution in database.")
             return self.solutions[query_state]
         print("No exact match in DB. Solving puzzle directly...")
-        solution_path = self.solve_single_puzzle(query_state)
+        solution_path = self.solve_single_puzzle(query_state, deadline_micros=deadline_micros)
         if solution_path:
             print("New puzzle solved! Adding solution to in-memory database.")
             self.add_solution_to_database(query_state, solution_path)
@@ -230,5 +392,65 @@ class PuzzleService:
             print("Direct A* solver could not find a solution for this state.")
         return solution_path
 
+    def _get_executor(self):
+        """The shared C++ solve executor, started on first use."""
+        if self.cpp_executor is None and CPP_SOLVER_AVAILABLE:
+            if self.grid_size == 3:
+                self.cpp_executor = cpp_solver.Executor3x3()
+            elif self.grid_size == 4:
+                self.cpp_executor = cpp_solver.Executor4x4()
+        return self.cpp_executor
+
+    async def solve_using_database_async(self, query_state: Tuple[int, ...],
+                                         deadline_micros: int = 0) -> List[Tuple[int, ...]]:
+        """
+        Coroutine twin of solve_using_database. Exact store lookups stay on
+        the event loop (they cost microseconds); an actual search is
+        submitted to the C++ executor and awaited, so the loop keeps
+        serving requests while worker threads solve off the GIL. Identical
+        states submitted concurrently share a single search.
+        """
+        if self.solution_store is not None:
+            moves = self.solution_store.lookup(list(query_state))
+            if moves is not None:
+                print("Found exact solution in native store.")
+                return self.replay_moves(query_state, moves)
+        if query_state in self.solutions:
+            print("Found exact solution in database.")
+            return self.solutions[query_state]
+
+        executor = self._get_executor()
+        if executor is None:
+            # No native module: run the blocking fallback on a thread so
+            # the event loop at least stays responsive.
+            loop = asyncio.get_running_loop()
+            return await loop.run_in_executor(
+                None, lambda: self.solve_using_database(query_state, deadline_micros))
+
+        print("No exact match in DB. Solving puzzle on the executor...")
+        seed = self._nearest_seed(query_state) if self.solution_store is not None else None
+        future = executor.submit(
+            list(query_state), deadline_micros=deadline_micros,
+            seed_state=seed[0] if seed else None,
+            seed_moves=seed[1] if seed else None)
+
+        loop = asyncio.get_running_loop()
+        aio_future = loop.create_future()
+
+        def deliver(path_of_moves):
+            # Runs on the executor worker thread that finished the solve.
+            loop.call_soon_threadsafe(aio_future.set_result, path_of_moves)
+
+        future.add_done_callback(deliver)
+        path_of_moves = await aio_future
+
+        if path_of_moves is None:
+            print("Direct A* solver could not find a solution for this state.")
+            return []
+        solution_path = self.replay_moves(query_state, path_of_moves)
+        print("New puzzle solved! Adding solution to in-memory database.")
+        self.add_solution_to_database(query_state, solution_path)
+        return solution_path
+
     
     
\ No newline at end of file